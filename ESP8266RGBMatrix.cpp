@@ -1,7 +1,83 @@
 #include "ESP8266RGBMatrix.h"
+#ifdef MMU_IRAM_HEAP
+#include <umm_malloc/umm_heap_select.h>
+#endif
 
 #define DBG_PORT Serial
 
+// Transpose a 8x8 bit matrix : byte i bit p <-> byte p bit i
+// (8 pixel values in, one byte per bitplane out with pixel i in bit i)
+static inline uint64_t transpose8(uint64_t x) {
+	uint64_t t;
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	return x ^ t ^ (t << 28);
+}
+
+static inline uint64_t load8(const uint8_t* v) {
+	return (uint32_t)(v[0] | (v[1] << 8) | (v[2] << 16) | ((uint32_t)v[3] << 24))
+		| ((uint64_t)(uint32_t)(v[4] | (v[5] << 8) | (v[6] << 16) | ((uint32_t)v[7] << 24)) << 32);
+}
+
+// Place the 4 pixels of a nibble (pixel i in bit i) where a groupStruct cfg nibble says
+static const uint8_t reverse4[16] = {0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF};
+static inline uint8_t placeNibble(uint8_t v, uint8_t cfg) {
+	return ((cfg & 0x08) ? reverse4[v] : v) << (cfg & 0x07);
+}
+static inline uint8_t extractNibble(uint8_t v, uint8_t cfg) {
+	v = (v >> (cfg & 0x07)) & 0x0F;
+	return (cfg & 0x08) ? reverse4[v] : v;
+}
+static inline uint8_t reverse8(uint8_t v) {
+	return (reverse4[v & 0x0F] << 4) | reverse4[v >> 4];
+}
+
+// 8 bits of a bit row from bit s, the bits out of 0..width - 1 are 0 or wrapped. One padding byte after the row
+static uint8_t extractBits(const uint8_t* row, int16_t s, uint16_t width, bool wrap) {
+	if ((s >= 0) && (s + 8 <= width))
+		return (row[s >> 3] | (row[(s >> 3) + 1] << 8)) >> (s & 7);
+	uint8_t bits = 0;
+	for (uint8_t i = 0; i < 8; i++) {
+		int16_t b = s + i;
+		if (wrap)
+			b = ((b % width) + width) % width;
+		else if ((b < 0) || (b >= width))
+			continue;
+		if (row[b >> 3] & (1 << (b & 7)))
+			bits |= 1 << i;
+	}
+	return bits;
+}
+
+// Scale the 8 values bit sliced in 8 plane bytes (plane p in byte p) through a lookup table
+static inline void scalePlanes(uint8_t* planes, const uint8_t* lut) {
+	uint64_t values = transpose8(load8(planes));
+	uint8_t scaled[8];
+	for (uint8_t i = 0; i < 8; i++, values >>= 8)
+		scaled[i] = lut[(uint8_t)values];
+	uint64_t out = transpose8(load8(scaled));
+	for (uint8_t p = 0; p < 8; p++, out >>= 8)
+		planes[p] = out;
+}
+
+// Blend the 8 values bit sliced in 8 plane bytes with the 8 of other planes, weight 0 - 256 of the other ones
+static inline void blendPlanes(uint8_t* planes, const uint8_t* other, uint16_t weight) {
+	uint64_t values = transpose8(load8(planes));
+	uint64_t others = transpose8(load8(other));
+	uint8_t blended[8];
+	for (uint8_t i = 0; i < 8; i++, values >>= 8, others >>= 8)
+		blended[i] = ((uint8_t)values * (256 - weight) + (uint8_t)others * weight + 128) >> 8;
+	uint64_t out = transpose8(load8(blended));
+	for (uint8_t p = 0; p < 8; p++, out >>= 8)
+		planes[p] = out;
+}
+
+// ROM function routing the FRC1 (timer1) interrupt to the NMI vector
+extern "C" void NmiTimSetFunc(void (*func)(void));
+
 #ifdef DEBUG_RGBMatrix
 #define DEBUGLOG(...) DBG_PORT.printf(__VA_ARGS__)
 #else
@@ -14,12 +90,35 @@
 ESP8266RGBMatrix::ESP8266RGBMatrix() {
 	//initialisation
 	_isBegin = false;
+	_isEnabled = false;
+	_nmi = false;
+	_arena = nullptr;
+	_arenaSize = 0;
+	_arenaLocation = BUFFER_DRAM;
+	_arenaRequest = BUFFER_DRAM;
+	_bufferLocation = BUFFER_DRAM;
+	_buffer = nullptr;
+	_buffer2 = nullptr;
+	_drawRedirected = false;
+	_scratch = nullptr;
+	_scratchSize = 0;
+	_muxSeq = nullptr;
+	_muxSeqSize = 0;
+	_row_offset = nullptr;
+	_rowOffsetSize = 0;
+	_group_map = nullptr;
+	_groupMapSize = 0;
+	_groupMapValid = false;
+	_mask_D = 0;
+	_mask_E = 0;
 	_display_row = 0;
 	_display_layer = 0;
 
 	//default values
 	_colorDepth = RGBMATRIX_DEFAULT_COLOR_DEPTH;
 	_framesPerSec = 1000;
+	_subTickSlices = true;
+	_burstLayers = 0;
 
 	_brightness = 255;
 	_rotate = false;
@@ -29,6 +128,15 @@ ESP8266RGBMatrix::ESP8266RGBMatrix() {
 	_block_pattern = ABCD;
 	_panels_width = 1;
 	setColorOffset(0,0,0);
+
+	_cyclesPerTick = 16;
+	_jitterArmed = false;
+	_jitterReset = true;
+	memset(&_jitter, 0, sizeof(_jitter));
+	_statsReset = false;
+	_swapFrame = 0;
+	memset(&_stats, 0, sizeof(_stats));
+	_statsStart = 0;
 }
 
 void ESP8266RGBMatrix::setGPIO(uint8_t gpio_OE, uint8_t gpio_LAT, uint8_t gpio_A, uint8_t gpio_B, uint8_t gpio_C) {
@@ -84,6 +192,69 @@ void ESP8266RGBMatrix::begin(uint16_t width, uint16_t height, uint8_t colorDepth
 }
 
 void ESP8266RGBMatrix::begin(uint16_t width, uint16_t height, uint8_t colorDepth, bool doubleBuffer) {
+	bool wasEnabled = _isEnabled;
+	bool nmi = _nmi;
+	if (wasEnabled)
+		disable();
+	init(width, height, colorDepth, doubleBuffer);
+	if (wasEnabled && _isBegin)
+		enable(nmi);
+}
+
+bool ESP8266RGBMatrix::reconfigure(uint8_t colorDepth, bool doubleBuffer, uint8_t panels_width, scan_patterns scan_pattern) {
+	if (!_isBegin){
+		DEBUGLOG("Must call begin() before reconfigure()");
+		return false;
+	}
+	uint16_t panelWidth = _width / _panels_width;
+	_panels_width = panels_width>1?panels_width:1;
+	_scan_pattern = scan_pattern;
+	begin(panelWidth * _panels_width, _height, colorDepth, doubleBuffer);
+	return _isBegin;
+}
+
+bool ESP8266RGBMatrix::initBuffers() {
+	// Both buffers live in one arena, only reallocated when it has to grow,
+	// so switching between configurations doesn't fragment the heap. An IRAM request that fell back
+	// to DRAM is not retried until the location setting changes
+	uint32_t planesSize = (_colorDepth * _bufferSize + 3) & ~3;
+	uint32_t arenaSize = _doubleBuffer ? 2 * planesSize : planesSize;
+	if ((arenaSize > _arenaSize) || (_arenaRequest != _bufferLocation)){
+		delete[] _arena;
+		_arena = nullptr;
+#ifdef MMU_IRAM_HEAP
+		if (_bufferLocation == BUFFER_IRAM){
+			HeapSelectIram ephemeral;
+			_arena = new (std::nothrow) uint8_t[arenaSize];
+			DEBUGLOG("Frame buffers in IRAM : %s\r\n", _arena ? "yes" : "no, fallback to DRAM");
+		}
+#endif
+		_arenaLocation = _arena ? BUFFER_IRAM : BUFFER_DRAM;
+		_arenaRequest = _bufferLocation;
+		if (!_arena)
+			_arena = new (std::nothrow) uint8_t[arenaSize];
+		if (!_arena){
+			DEBUGLOG("Can't allocate %u bytes for the frame buffers\r\n", arenaSize);
+			_arenaSize = 0;
+			_buffer = _buffer2 = _edit_buffer = _display_buffer = nullptr;
+			return false;
+		}
+		_arenaSize = arenaSize;
+	}
+	clearWords(_arena, arenaSize);
+
+	_buffer = _arena;
+	_buffer2 = _doubleBuffer ? _arena + planesSize : nullptr;
+	_display_buffer = _buffer;
+	_display_buffer_pos = _display_buffer;
+	_active_buffer = false;
+	_edit_buffer = _doubleBuffer ? _buffer2 : _buffer;
+	_drawRedirected = false;
+	return true;
+}
+
+void ESP8266RGBMatrix::init(uint16_t width, uint16_t height, uint8_t colorDepth, bool doubleBuffer) {
+	_isBegin = false;
 	_width = width;
 	_height = height;
 	_doubleBuffer = doubleBuffer;
@@ -94,25 +265,22 @@ void ESP8266RGBMatrix::begin(uint16_t width, uint16_t height, uint8_t colorDepth
 	_bufferSize = (_height * _width * 3 / 8);
 	_patternColorBytes = (_height / _rowPattern) * (_width / 8);
 	_sendBufferSize = _patternColorBytes * 3;
+	// The refresh restarts on row 0 : put the mux back to row 0 for the Gray code sequence
+	_display_row = 0;
+	_display_layer = 0;
+	_groupMapValid = false;
+	GPIO_REG_WRITE(GPIO_OUT_W1TC_ADDRESS, _mask_A | _mask_B | _mask_C | _mask_D | _mask_E);
 
 	if (_rowPattern == 4)
 		_scan_pattern = ZIGZAG;
 
 	//Gestion des buffers
-	_buffer = new uint8_t[_colorDepth * _bufferSize];
-	_display_buffer = _buffer;
-	_display_buffer_pos = _display_buffer;
-	_active_buffer = false;
-	if (_doubleBuffer){
-		_buffer2 = new uint8_t[_colorDepth * _bufferSize];
-		_edit_buffer = _buffer2;
-	}
-	else
-		_edit_buffer = _buffer;
+	if (!initBuffers())
+		return;
 
 	initShowTicks();
-	initPatternSeq();
-	initPreIndex();
+	if (!initPatternSeq() || !initPreIndex())
+		return;
 	init_SPIBufferSize();
 	
 #ifdef DEBUG_RGBMatrix
@@ -136,7 +304,11 @@ void ESP8266RGBMatrix::begin(uint16_t width, uint16_t height, uint8_t colorDepth
 	
 	DEBUGLOG("Layer sequence :\r\n");
 	uint32_t timePerImage = 0;
-	for (uint8_t i = 0; i < _colorDepth; i++){
+	for (uint8_t i = 0; i < _burstLayers; i++){
+		DEBUGLOG("%#6u (cycles, in ISR)  %#5u (us per layer) \r\n", _burstCycles[i], _rowPattern*_burstCycles[i]/(5*_cyclesPerTick));
+		timePerImage += _rowPattern*_burstCycles[i]/(5*_cyclesPerTick);
+	}
+	for (uint8_t i = _burstLayers; i < _colorDepth; i++){
 		uint16_t temp_showTicks = _showTicks*(1<<i);
 		DEBUGLOG("%#4u (timer_ticks)  %#4u (us per row)  %#6u (cycles per row)  %#5u (us per layer) \r\n", temp_showTicks, temp_showTicks/5, temp_showTicks * 16 * (CPU2X ? 2 : 1), _rowPattern*temp_showTicks/5);
 		timePerImage += _rowPattern*temp_showTicks/5;
@@ -153,22 +325,51 @@ void ESP8266RGBMatrix::init_SPIBufferSize() {
 }
 
 void ESP8266RGBMatrix::initShowTicks() {
-	// 10000[ms]/ 25[img/s] / 1000[pour se mettre à la mS]
-	uint32_t showticks = 5*1000*(1000/_framesPerSec)/_rowPattern/((1<<_colorDepth)-1);
+	_cyclesPerTick = ESP.getCpuFreqMHz() / 5;	// Timer1 runs at 5MHz with TIM_DIV16
+
+	// LSB slice in CPU cycles : 1[s] / _framesPerSec / _rowPattern / (2^_colorDepth - 1)
+	uint32_t lsbCycles = ESP.getCpuFreqMHz() * 1000000UL / _framesPerSec / _rowPattern / ((1<<_colorDepth)-1);
+	uint32_t showticks = lsbCycles / _cyclesPerTick;
 
 	// 5[coefTimer1] * 1 000 000 [en ms] * _sendBufferSize*8 [Bits send] / RGBMATRIX_SPI_FREQUENCY [SPI Debit] 
 	//entre 50 et 25K ticks 
 	uint32_t minShowTicks = 5*1000000*_sendBufferSize*8/RGBMATRIX_SPI_FREQUENCY;
 	DEBUGLOG("Minimum ShowTicks = %u at SPI = %u Hz",  minShowTicks, RGBMATRIX_SPI_FREQUENCY);
-	if (showticks < minShowTicks)
-		showticks = minShowTicks;
+
+	// Slices shorter than the SPI shift can't be timed by timer1 : emit them back to back
+	// inside one interrupt with cycle counted OE pulses. The MSB slice always uses the timer.
+	_burstLayers = 0;
+	if (_subTickSlices)
+		while ((_burstLayers < _colorDepth-1) && ((showticks<<_burstLayers) < minShowTicks))
+			_burstLayers++;
+
+	// Even the first timer slice is too short : lower the frame rate
+	if ((showticks<<_burstLayers) < minShowTicks) {
+		showticks = (minShowTicks + (1<<_burstLayers) - 1) >> _burstLayers;
+		lsbCycles = showticks * _cyclesPerTick;
+	}
+	for (uint8_t i = 0; i < _burstLayers; i++)
+		_burstCycles[i] = lsbCycles << i;
 	_showTicks = showticks;
 }
 
-void ESP8266RGBMatrix::initPatternSeq(){
-	if (_muxSeq)
-		delete _muxSeq;
-	_muxSeq = new muxStruct[_rowPattern];
+void ESP8266RGBMatrix::setSubTickSlices(bool enable) {
+	_subTickSlices = enable;
+	if (_isBegin)
+		initShowTicks();
+}
+
+bool ESP8266RGBMatrix::initPatternSeq(){
+	// Grown only, as the arena
+	if (_rowPattern > _muxSeqSize){
+		delete[] _muxSeq;
+		_muxSeq = new (std::nothrow) muxStruct[_rowPattern];
+		_muxSeqSize = _muxSeq ? _rowPattern : 0;
+		if (!_muxSeq){
+			DEBUGLOG("Can't allocate the row pattern sequence\r\n");
+			return false;
+		}
+	}
 	DEBUGLOG("Row pattern sequence :\r\n");
 	// Utilisation du code de Gray pour ne changer l'état que d'un seul bit à la fois lors du scan, donc 1 seule écriture sur le registre de sortie
 	// Thanks Mr Frank Gray 
@@ -197,14 +398,22 @@ void ESP8266RGBMatrix::initPatternSeq(){
 		DEBUGLOG("%#2u| - %04u(%02u) vers %04u(%02u) cmd:%u %08u offset %#4u\r\n", i, D2B(prevIndex),prevIndex,D2B(newIndex),newIndex, _muxSeq[i].cmd, D2B(_muxSeq[i].val), _muxSeq[i].offset);
 		prevIndex = newIndex;
 	}
+	return true;
 }
 
-void ESP8266RGBMatrix::initPreIndex(){
-	if (_row_offset)
-		delete _row_offset;
-	_row_offset = new uint32_t[_height];
+bool ESP8266RGBMatrix::initPreIndex(){
+	if (_height > _rowOffsetSize){
+		delete[] _row_offset;
+		_row_offset = new (std::nothrow) uint32_t[_height];
+		_rowOffsetSize = _row_offset ? _height : 0;
+		if (!_row_offset){
+			DEBUGLOG("Can't allocate the row offsets\r\n");
+			return false;
+		}
+	}
  	for (uint8_t yy = 0; yy < _height; yy++)
 		_row_offset[yy] = ((yy) % _rowPattern) * _sendBufferSize + _sendBufferSize - 1;
+	return true;
 }
 
 void ESP8266RGBMatrix::setBrightness(uint8_t brightness) {
@@ -213,7 +422,18 @@ void ESP8266RGBMatrix::setBrightness(uint8_t brightness) {
 }
 
 void ESP8266RGBMatrix::showBuffer() {
+	// The edit buffer is not the one drawn to : the swap would show a frame not drawn yet
+	if (_drawRedirected){
+		DEBUGLOG("showBuffer() while drawing is redirected\r\n");
+		return;
+	}
 	if (_doubleBuffer){
+		// A swap before any complete frame was shown means the previous frame was never displayed entirely
+		_stats.swaps++;
+		uint32_t frames = ((volatile refreshStats*)&_stats)->frames;
+		if (frames == _swapFrame)
+			_stats.droppedSwaps++;
+		_swapFrame = frames;
 		_active_buffer = !_active_buffer;
 		_display_buffer = _active_buffer ? _buffer2 : _buffer;
 		_display_buffer_pos = _display_buffer + _display_layer * _bufferSize + _muxSeq[_display_row].offset;
@@ -222,37 +442,60 @@ void ESP8266RGBMatrix::showBuffer() {
 }
 
 void ESP8266RGBMatrix::clearDisplay() {
-	clearDisplay(!_active_buffer);
+	if (_edit_buffer)
+		clearWords(_edit_buffer, _colorDepth * _bufferSize);
 }
 
 void ESP8266RGBMatrix::clearDisplay(bool selected_buffer) {
 	if (_doubleBuffer)
-		memset(selected_buffer ? _buffer2 : _buffer, 0, sizeof(_buffer));
+		clearWords(selected_buffer ? _buffer2 : _buffer, _colorDepth * _bufferSize);
 	else
-		memset(_buffer, 0, sizeof(_buffer));
+		clearWords(_buffer, _colorDepth * _bufferSize);
 }
 
 void ESP8266RGBMatrix::copyBuffer(bool reverse = false) {
 	// This copies the display buffer to the drawing buffer (or reverse)
 	// You may need this in case you rely on the framebuffer to always contain the last frame
-	// _active_buffer = true means that PxMATRIX_buffer2 is displayed
+	// The drawing buffer is the draw target when drawing is redirected
 	if (_doubleBuffer){
-		if (_active_buffer ^ reverse)
-			memcpy(_buffer, _buffer2, sizeof(_buffer));
+		if (reverse)
+			copyWords(_display_buffer, _edit_buffer, _colorDepth * _bufferSize);
 		else
-			memcpy(_buffer2, _buffer, sizeof(_buffer2));
+			copyWords(_edit_buffer, _display_buffer, _colorDepth * _bufferSize);
 	}
 }
 
+void ESP8266RGBMatrix::setDrawTarget(uint8_t* frame) {
+	if (!_isBegin)
+		return;
+	_drawRedirected = frame != nullptr;
+	if (frame)
+		_edit_buffer = frame;
+	else if (_doubleBuffer)
+		_edit_buffer = _active_buffer ? _buffer : _buffer2;
+	else
+		_edit_buffer = _buffer;
+}
+
 void ESP8266RGBMatrix::setColorOffset(uint8_t r, uint8_t g, uint8_t b) {
 	_color_R_offset = r;
 	_color_G_offset = g;
 	_color_B_offset = b;
 }
 
-void ESP8266RGBMatrix::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) {
-	uint8_t rows_per_buffer = (_height / 2);
+uint32_t ESP8266RGBMatrix::getLayoutSignature() {
+	// FNV-1a of everything setPixel() depends on
+	uint8_t layout[] = {(uint8_t)_width, (uint8_t)(_width>>8), (uint8_t)_height, (uint8_t)(_height>>8),
+						_colorDepth, _rowPattern, (uint8_t)_scan_pattern, (uint8_t)_block_pattern,
+						(uint8_t)_color_order, _panels_width, _rotate, _flip,
+						_color_R_offset, _color_G_offset, _color_B_offset};
+	uint32_t hash = 2166136261UL;
+	for (uint8_t i = 0; i < sizeof(layout); i++)
+		hash = (hash ^ layout[i]) * 16777619UL;
+	return hash;
+}
 
+void ESP8266RGBMatrix::applyColorSettings(uint8_t &r, uint8_t &g, uint8_t &b) {
 	if (r > _color_R_offset)
 		r -= _color_R_offset;
 	else
@@ -266,6 +509,44 @@ void ESP8266RGBMatrix::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint
 	else
 		b = 0;
 
+	if (_color_order != RRGGBB) {
+		uint8_t r_temp = r;
+		uint8_t g_temp = g;
+		uint8_t b_temp = b;
+
+		switch (_color_order) {
+			case (RRGGBB):
+				break;
+			case (RRBBGG):
+				g = b_temp;
+				b = g_temp;
+				break;
+			case (GGRRBB):
+				r = g_temp;
+				g = r_temp;
+				break;
+			case (GGBBRR):
+				r = g_temp;
+				g = b_temp;
+				b = r_temp;
+				break;
+			case (BBRRGG):
+				r = b_temp;
+				g = r_temp;
+				b = g_temp;
+				break;
+			case (BBGGRR):
+				r = b_temp;
+				g = g_temp;
+				b = r_temp;
+				break;
+		}
+	}
+}
+
+bool ESP8266RGBMatrix::mapPixel(int16_t x, int16_t y, uint32_t &total_offset_r, uint8_t &bit_select) {
+	uint8_t rows_per_buffer = (_height / 2);
+
 	if (_block_pattern == DBCA) {
 		// Every matrix is segmented in 8 blocks - 2 in X, 4 in Y direction
 		// |AB|
@@ -308,46 +589,10 @@ void ESP8266RGBMatrix::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint
 		x = _width - 1 - x;
 
 	if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height))
-		return;
-
-	if (_color_order != RRGGBB) {
-		uint8_t r_temp = r;
-		uint8_t g_temp = g;
-		uint8_t b_temp = b;
-
-		switch (_color_order) {
-			case (RRGGBB):
-				break;
-			case (RRBBGG):
-				g = b_temp;
-				b = g_temp;
-				break;
-			case (GGRRBB):
-				r = g_temp;
-				g = r_temp;
-				break;
-			case (GGBBRR):
-				r = g_temp;
-				g = b_temp;
-				b = r_temp;
-				break;
-			case (BBRRGG):
-				r = b_temp;
-				g = r_temp;
-				b = g_temp;
-				break;
-			case (BBGGRR):
-				r = b_temp;
-				g = g_temp;
-				b = r_temp;
-				break;
-		}
-	}
+		return false;
 
 	uint32_t base_offset;
-	uint32_t total_offset_r = 0;
-	uint32_t total_offset_g = 0;
-	uint32_t total_offset_b = 0;
+	total_offset_r = 0;
 
 	if (_scan_pattern == WZAGZIG || _scan_pattern == VZAG || _scan_pattern == WZAGZIG2) {
 		// get block coordinates and constraints
@@ -418,7 +663,7 @@ void ESP8266RGBMatrix::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint
 		total_offset_r = _row_offset[y] - in_row_byte_offset - _panel_width_bytes * ((rows_per_buffer / _rowPattern) * (_panels_width * which_buffer + which_panel) + vert_index_in_buffer);
 	}
 
-	uint8_t bit_select = x % 8;
+	bit_select = x % 8;
 
 	// Normally the bytes in one buffer would be sequencial, e.g.
 	// 0-1-2-3-
@@ -481,6 +726,19 @@ void ESP8266RGBMatrix::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint
 			}
 		}
 	}
+	// ZZIAGG pushes half of the upper part pixels out of the byte : they were never drawn
+	return bit_select < 8;
+}
+
+void ESP8266RGBMatrix::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) {
+	uint32_t total_offset_r;
+	uint32_t total_offset_g;
+	uint32_t total_offset_b;
+	uint8_t bit_select;
+
+	if (!mapPixel(x, y, total_offset_r, bit_select))
+		return;
+	applyColorSettings(r, g, b);
 
 	total_offset_g = total_offset_r - _patternColorBytes;
 	total_offset_b = total_offset_g - _patternColorBytes;
@@ -491,51 +749,728 @@ void ESP8266RGBMatrix::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint
 
 	//Color interlacing
 	for (int this_color_bit = 0; this_color_bit < _colorDepth; this_color_bit++) {
-		if ((r >> this_color_bit) & 0x01)
-			_edit_buffer[this_color_bit * _bufferSize + total_offset_r] |= _BV(bit_select);
-		else
-			_edit_buffer[this_color_bit * _bufferSize + total_offset_r] &= ~_BV(bit_select);
+		writeBit(_edit_buffer, this_color_bit * _bufferSize + total_offset_r, bit_select, (r >> this_color_bit) & 0x01);
+		writeBit(_edit_buffer, this_color_bit * _bufferSize + total_offset_g, bit_select, (g >> this_color_bit) & 0x01);
+		writeBit(_edit_buffer, this_color_bit * _bufferSize + total_offset_b, bit_select, (b >> this_color_bit) & 0x01);
+	}
+}
 
-		if ((g >> this_color_bit) & 0x01)
-			_edit_buffer[this_color_bit * _bufferSize + total_offset_g] |= _BV(bit_select);
-		else
-			_edit_buffer[this_color_bit * _bufferSize + total_offset_g] &= ~_BV(bit_select);
+bool ESP8266RGBMatrix::initGroupMap() {
+	// Every scan pattern keeps 4 consecutive pixels in one byte, in order or reversed :
+	// check it for each group from the real mapping rather than assuming it
+	uint32_t size = _height * ((_width + 7) / 8);
+	if (size != _groupMapSize){
+		delete[] _group_map;
+		_group_map = new (std::nothrow) groupStruct[size];
+		_groupMapSize = _group_map ? size : 0;
+		if (!_group_map)
+			return false;
+	}
+	groupStruct* group = _group_map;
+	for (int16_t y = 0; y < _height; y++) {
+		for (int16_t x = 0; x < _width; x += 8, group++) {
+			uint32_t offset[8];
+			uint8_t bit[8];
+			bool valid = true;
+			for (uint8_t i = 0; i < 8; i++)
+				valid &= mapPixel(x + i, y, offset[i], bit[i]);
+			uint8_t cfg = 0;
+			for (uint8_t n = 0; valid && (n < 2); n++) {
+				const uint32_t* o = offset + 4 * n;
+				const uint8_t* b = bit + 4 * n;
+				bool up = (b[1] == b[0] + 1) && (b[2] == b[0] + 2) && (b[3] == b[0] + 3);
+				bool down = (b[1] == b[0] - 1) && (b[2] == b[0] - 2) && (b[3] == b[0] - 3);
+				valid = (o[1] == o[0]) && (o[2] == o[0]) && (o[3] == o[0]) && (up || down) && ((up ? b[0] : b[3]) <= 4);
+				cfg |= (up ? b[0] : (b[3] | 0x08)) << (4 * n);
+			}
+			int32_t offset_hi = (int32_t)offset[4] - (int32_t)offset[0];
+			valid = valid && (offset_hi >= -128) && (offset_hi <= 127) && (offset[0] <= 0xFFFF);
+			group->offset = valid ? offset[0] : 0;
+			group->offset_hi = valid ? offset_hi : 0;
+			group->cfg = valid ? cfg : 0xFF;
+		}
+	}
+	_groupMapValid = true;
+	return true;
+}
 
-		if ((b >> this_color_bit) & 0x01)
-			_edit_buffer[this_color_bit * _bufferSize + total_offset_b] |= _BV(bit_select);
-		else
-			_edit_buffer[this_color_bit * _bufferSize + total_offset_b] &= ~_BV(bit_select);
+void ESP8266RGBMatrix::encodeGroup(uint8_t* buffer, int16_t x, int16_t y, const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t pixels) {
+	// r, g, b : 8 values already shifted to _colorDepth bits, one byte per bitplane for each color
+	uint8_t planeBits[3 * 8];
+	const uint8_t* colors[3] = {r, g, b};
+	for (uint8_t c = 0; c < 3; c++) {
+		uint64_t planes = transpose8(load8(colors[c]));
+		for (uint8_t p = 0; p < 8; p++, planes >>= 8)
+			planeBits[8 * c + p] = planes;
+	}
+	writeGroup(buffer, x, y, planeBits, pixels);
+}
+
+void ESP8266RGBMatrix::readGroup(const uint8_t* buffer, int16_t x, int16_t y, uint8_t* planeBits) {
+	// Inverse of writeGroup(), the pixels out of the panel read 0
+	const groupStruct* group = _groupMapValid ? &_group_map[y * ((_width + 7) / 8) + (x >> 3)] : nullptr;
+	if (!group || (group->cfg == 0xFF)) {
+		memset(planeBits, 0, 3 * 8);
+		for (uint8_t i = 0; i < 8; i++) {
+			uint32_t offset;
+			uint8_t bit;
+			if (!mapPixel(x + i, y, offset, bit))
+				continue;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++)
+					if (readByte(buffer, p * _bufferSize + offset - c * _patternColorBytes) & (1 << bit))
+						planeBits[8 * c + p] |= 1 << i;
+		}
+		return;
+	}
+
+	uint8_t cfg_lo = group->cfg & 0x0F;
+	uint8_t cfg_hi = group->cfg >> 4;
+	for (uint8_t c = 0; c < 3; c++) {
+		uint32_t offset = group->offset - c * _patternColorBytes;
+		for (uint8_t p = 0; p < _colorDepth; p++, offset += _bufferSize) {
+			uint8_t lo = readByte(buffer, offset);
+			uint8_t hi = group->offset_hi ? readByte(buffer, offset + group->offset_hi) : lo;
+			planeBits[8 * c + p] = extractNibble(lo, cfg_lo) | (extractNibble(hi, cfg_hi) << 4);
+		}
+	}
+}
+
+void ESP8266RGBMatrix::writeGroup(uint8_t* buffer, int16_t x, int16_t y, const uint8_t* planeBits, uint8_t pixels) {
+	// x multiple of 8, planeBits[8 * color + plane] : pixel i in bit i, pixels : bit i set if pixel i is written
+	const groupStruct* group = _groupMapValid ? &_group_map[y * ((_width + 7) / 8) + (x >> 3)] : nullptr;
+	if (!group || (group->cfg == 0xFF)) {
+		// Layout splitting the group (or no map) : pixel by pixel
+		for (uint8_t i = 0; i < 8; i++) {
+			uint32_t offset;
+			uint8_t bit;
+			if (!(pixels & (1 << i)) || !mapPixel(x + i, y, offset, bit))
+				continue;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++)
+					writeBit(buffer, p * _bufferSize + offset - c * _patternColorBytes, bit, (planeBits[8 * c + p] >> i) & 0x01);
+		}
+		return;
+	}
+
+	uint8_t cfg_lo = group->cfg & 0x0F;
+	uint8_t cfg_hi = group->cfg >> 4;
+	uint8_t mask_lo = placeNibble(pixels & 0x0F, cfg_lo);
+	uint8_t mask_hi = placeNibble(pixels >> 4, cfg_hi);
+	bool sameByte = !group->offset_hi;
+	for (uint8_t c = 0; c < 3; c++) {
+		uint32_t offset = group->offset - c * _patternColorBytes;
+		for (uint8_t p = 0; p < _colorDepth; p++, offset += _bufferSize) {
+			uint8_t bits = planeBits[8 * c + p];
+			uint8_t lo = placeNibble(bits & 0x0F, cfg_lo);
+			uint8_t hi = placeNibble(bits >> 4, cfg_hi);
+			if (sameByte)
+				writeBits(buffer, offset, lo | hi, mask_lo | mask_hi);
+			else {
+				if (mask_lo)	writeBits(buffer, offset, lo, mask_lo);
+				if (mask_hi)	writeBits(buffer, offset + group->offset_hi, hi, mask_hi);
+			}
+		}
+	}
+}
+
+void ESP8266RGBMatrix::writeRGB888(int16_t x, int16_t y, const uint8_t* rgb, uint16_t count) {
+	if ((y < 0) || (y >= _height) || !_isBegin)
+		return;
+	if (x < 0) {
+		if (count <= -x)
+			return;
+		rgb += -x * 3;
+		count += x;
+		x = 0;
+	}
+	if (x >= _width)
+		return;
+	if (x + count > _width)
+		count = _width - x;
+	if (!_groupMapValid)
+		initGroupMap();
+
+	uint8_t r[8] = {0}, g[8] = {0}, b[8] = {0};
+	uint8_t shift = 8 - _colorDepth;
+	while (count) {
+		uint8_t first = x & 7;
+		uint8_t n = 8 - first;
+		if (n > count)
+			n = count;
+		for (uint8_t i = first; i < first + n; i++, rgb += 3) {
+			uint8_t rr = rgb[0], gg = rgb[1], bb = rgb[2];
+			applyColorSettings(rr, gg, bb);
+			r[i] = rr >> shift;
+			g[i] = gg >> shift;
+			b[i] = bb >> shift;
+		}
+		encodeGroup(_edit_buffer, x - first, y, r, g, b, ((1 << n) - 1) << first);
+		x += n;
+		count -= n;
+	}
+}
+
+void ESP8266RGBMatrix::writeRGB565(int16_t x, int16_t y, const uint16_t* rgb565, uint16_t count) {
+	// Expanded 8 pixels at a time
+	uint8_t rgb[8 * 3];
+	while (count) {
+		uint8_t n = count > 8 ? 8 : count;
+		for (uint8_t i = 0; i < n; i++)
+			rgb565to888(rgb565[i], rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+		writeRGB888(x, y, rgb, n);
+		x += n;
+		count -= n;
+		rgb565 += n;
 	}
 }
 
+uint8_t* ESP8266RGBMatrix::scratch(uint32_t size) {
+	// The per frame primitives would churn the heap allocating at every call : one area grown as needed
+	if (size > _scratchSize){
+		delete[] _scratch;
+		_scratch = new (std::nothrow) uint8_t[size];
+		_scratchSize = _scratch ? size : 0;
+	}
+	return _scratch;
+}
+
+void ESP8266RGBMatrix::moveGroup(int16_t sx, int16_t sy, int16_t dx, int16_t dy, uint8_t pixels) {
+	// Groups laid out the same way in the planes (same bits, same byte distance) : their plane bytes are
+	// copied as they are under the pixels mask, else the group is decoded and encoded again
+	uint16_t groups = (_width + 7) / 8;
+	const groupStruct* from = _groupMapValid ? &_group_map[sy * groups + (sx >> 3)] : nullptr;
+	const groupStruct* to = _groupMapValid ? &_group_map[dy * groups + (dx >> 3)] : nullptr;
+	if (!from || !to || (from->cfg == 0xFF) || (from->cfg != to->cfg) || (from->offset_hi != to->offset_hi)) {
+		uint8_t planeBits[3 * 8];
+		readGroup(_edit_buffer, sx, sy, planeBits);
+		writeGroup(_edit_buffer, dx, dy, planeBits, pixels);
+		return;
+	}
+
+	uint8_t mask_lo = placeNibble(pixels & 0x0F, from->cfg & 0x0F);
+	uint8_t mask_hi = placeNibble(pixels >> 4, from->cfg >> 4);
+	if (!from->offset_hi) {
+		mask_lo |= mask_hi;
+		mask_hi = 0;
+	}
+	for (uint8_t c = 0; c < 3; c++) {
+		uint32_t s = from->offset - c * _patternColorBytes;
+		uint32_t d = to->offset - c * _patternColorBytes;
+		for (uint8_t p = 0; p < _colorDepth; p++, s += _bufferSize, d += _bufferSize) {
+			if (mask_lo)
+				writeBits(_edit_buffer, d, readByte(_edit_buffer, s), mask_lo);
+			if (mask_hi)
+				writeBits(_edit_buffer, d + from->offset_hi, readByte(_edit_buffer, s + from->offset_hi), mask_hi);
+		}
+	}
+}
+
+void ESP8266RGBMatrix::shiftRows(int16_t dx, bool wrap) {
+	if (!_isBegin)
+		return;
+	if (wrap) {
+		dx %= (int16_t)_width;
+		if (dx < 0)
+			dx += _width;
+	}
+	if (!dx)
+		return;
+	if (!_groupMapValid)
+		initGroupMap();
+
+	uint16_t groups = (_width + 7) / 8;
+	uint8_t planeBits[3 * 8];
+	if (!(dx & 7) && !(_width & 7)) {
+		// Whole groups : moved from the far side so each one is read before being overwritten,
+		// the groups wrapped to the other side are saved first
+		if (wrap && (dx > _width / 2))
+			dx -= _width;
+		int16_t shift = dx / 8;
+		uint16_t n = shift > 0 ? shift : -shift;
+		if (n > groups)
+			n = groups;
+		uint8_t* saved = wrap ? scratch(3 * 8 * n) : nullptr;
+		if (wrap && !saved)
+			return;
+		memset(planeBits, 0, sizeof(planeBits));
+		uint16_t out = dx > 0 ? groups - n : 0;		// First group moved out
+		uint16_t in = dx > 0 ? 0 : groups - n;		// First group moved in
+		for (int16_t y = 0; y < _height; y++) {
+			for (uint16_t i = 0; wrap && (i < n); i++)
+				readGroup(_edit_buffer, 8 * (out + i), y, saved + 3 * 8 * i);
+			for (uint16_t i = 0; i < groups - n; i++) {
+				int16_t g = dx > 0 ? groups - 1 - i : i;
+				moveGroup(8 * (g - shift), y, 8 * g, y, 0xFF);
+			}
+			for (uint16_t i = 0; i < n; i++)
+				writeGroup(_edit_buffer, 8 * (in + i), y, wrap ? saved + 3 * 8 * i : planeBits, 0xFF);
+		}
+		return;
+	}
+
+	// Else pixels change of group. The scan patterns split, reverse and interleave the nibbles of a row in
+	// the planes : it is not a bit string a multi-byte shift could move. Each row is decoded into bit rows,
+	// one per color and bitplane, then written back shifted 8 pixels at a time
+	uint16_t rowBytes = groups + 1;
+	uint8_t* bits = scratch(3 * _colorDepth * rowBytes);
+	if (!bits)
+		return;
+	uint8_t lastPixels = (_width & 7) ? (1 << (_width & 7)) - 1 : 0xFF;
+	for (int16_t y = 0; y < _height; y++) {
+		for (uint16_t g = 0; g < groups; g++) {
+			readGroup(_edit_buffer, 8 * g, y, planeBits);
+			uint8_t* row = bits;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++, row += rowBytes) {
+					row[g] = planeBits[8 * c + p];
+					row[groups] = 0;
+				}
+		}
+		for (uint16_t g = 0; g < groups; g++) {
+			const uint8_t* row = bits;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++, row += rowBytes)
+					planeBits[8 * c + p] = extractBits(row, 8 * g - dx, _width, wrap);
+			writeGroup(_edit_buffer, 8 * g, y, planeBits, g == groups - 1 ? lastPixels : 0xFF);
+		}
+	}
+}
+
+void ESP8266RGBMatrix::shiftColumns(int16_t dy, bool wrap) {
+	if (!_isBegin)
+		return;
+	if (wrap) {
+		dy %= (int16_t)_height;
+		if (dy > _height / 2)
+			dy -= _height;
+		else if (dy < -(_height / 2))
+			dy += _height;
+	}
+	if (!dy)
+		return;
+	if (!_groupMapValid)
+		initGroupMap();
+
+	// Rows are moved group by group from the far side so each one is read before being overwritten, the rows
+	// wrapped to the other side are saved first. Rows laid out the same way (always the case for a multiple
+	// of the scan rows) are copied in the planes without decoding
+	uint16_t groups = (_width + 7) / 8;
+	uint16_t n = dy > 0 ? dy : -dy;
+	if (n > _height)
+		n = _height;
+	uint8_t* saved = wrap ? scratch(3 * 8 * groups * n) : nullptr;
+	if (wrap && !saved)
+		return;
+	uint8_t black[3 * 8] = {0};
+	uint8_t lastPixels = (_width & 7) ? (1 << (_width & 7)) - 1 : 0xFF;
+	uint16_t out = dy > 0 ? _height - n : 0;		// First row moved out
+	uint16_t in = dy > 0 ? 0 : _height - n;			// First row moved in
+	for (uint16_t i = 0; wrap && (i < n); i++)
+		for (uint16_t g = 0; g < groups; g++)
+			readGroup(_edit_buffer, 8 * g, out + i, saved + 3 * 8 * (i * groups + g));
+	for (uint16_t i = 0; i < _height - n; i++) {
+		int16_t y = dy > 0 ? _height - 1 - i : i;
+		for (uint16_t g = 0; g < groups; g++)
+			moveGroup(8 * g, y - dy, 8 * g, y, g == groups - 1 ? lastPixels : 0xFF);
+	}
+	for (uint16_t i = 0; i < n; i++)
+		for (uint16_t g = 0; g < groups; g++)
+			writeGroup(_edit_buffer, 8 * g, in + i, wrap ? saved + 3 * 8 * (i * groups + g) : black, g == groups - 1 ? lastPixels : 0xFF);
+}
+
+void ESP8266RGBMatrix::copyRect(int16_t sx, int16_t sy, uint16_t width, uint16_t height, int16_t dx, int16_t dy, uint8_t transform) {
+	if (!_isBegin || !width || !height)
+		return;
+	if (!_groupMapValid)
+		initGroupMap();
+
+	// The area is read into bit rows (for each row, one per color and bitplane), transposed by 8x8 blocks
+	// if needed, then written 8 pixels at a time. Rows are padded to 8 for the transpose, and one more byte
+	uint8_t planes = 3 * _colorDepth;
+	bool transpose = transform & COPY_TRANSPOSE;
+	uint16_t rows = (height + 7) & ~7;
+	uint16_t rowBytes = (width + 7) / 8 + 1;
+	uint16_t copyWidth = transpose ? height : width;
+	uint16_t copyHeight = transpose ? width : height;
+	uint16_t copyRowBytes = transpose ? rows / 8 + 1 : rowBytes;
+	uint32_t areaSize = (uint32_t)rows * planes * rowBytes;
+	uint32_t copySize = transpose ? (uint32_t)((width + 7) & ~7) * planes * copyRowBytes : 0;
+	uint16_t groups = (width + 7) / 8 + 1;
+	uint8_t* area = scratch(areaSize + copySize + planes * (groups + 1));
+	if (!area)
+		return;
+	memset(area, 0, areaSize + copySize);
+	uint8_t* line = area + areaSize + copySize;
+
+	uint8_t planeBits[3 * 8];
+	for (uint16_t y = 0; y < height; y++) {
+		if ((sy + y < 0) || (sy + y >= _height))
+			continue;
+		// Panel groups covering the row, the pixels out of the panel read 0
+		int16_t g0 = sx >> 3;
+		memset(line, 0, planes * (groups + 1));
+		for (uint16_t g = 0; g < groups; g++) {
+			int16_t gx = 8 * (g0 + g);
+			if ((gx < 0) || (gx >= _width))
+				continue;
+			readGroup(_edit_buffer, gx, sy + y, planeBits);
+			for (uint8_t c = 0, k = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++, k++)
+					line[k * (groups + 1) + g] = planeBits[8 * c + p];
+		}
+		uint8_t* row = area + (uint32_t)y * planes * rowBytes;
+		for (uint8_t k = 0; k < planes; k++, row += rowBytes)
+			for (uint16_t b = 0; b < rowBytes - 1; b++)
+				row[b] = extractBits(line + k * (groups + 1), (sx & 7) + 8 * b, 8 * groups, false);
+	}
+
+	uint8_t* copy = area;
+	if (transpose) {
+		copy = area + areaSize;
+		for (uint16_t by = 0; by < rows / 8; by++)
+			for (uint16_t bx = 0; bx < rowBytes - 1; bx++)
+				for (uint8_t k = 0; k < planes; k++) {
+					uint8_t v[8];
+					for (uint8_t i = 0; i < 8; i++)
+						v[i] = area[((uint32_t)(8 * by + i) * planes + k) * rowBytes + bx];
+					uint64_t t = transpose8(load8(v));
+					for (uint8_t i = 0; i < 8; i++, t >>= 8)
+						copy[((uint32_t)(8 * bx + i) * planes + k) * copyRowBytes + by] = t;
+				}
+	}
+
+	for (uint16_t y = 0; y < copyHeight; y++) {
+		int16_t py = dy + y;
+		if ((py < 0) || (py >= _height))
+			continue;
+		uint16_t cy = (transform & COPY_FLIP_Y) ? copyHeight - 1 - y : y;
+		const uint8_t* row = copy + (uint32_t)cy * planes * copyRowBytes;
+		int16_t x0 = dx < 0 ? 0 : dx;
+		int16_t x1 = dx + copyWidth > _width ? _width : dx + copyWidth;
+		for (int16_t gx = x0 & ~7; gx < x1; gx += 8) {
+			// Copy pixel of the group pixel 0
+			int16_t s = gx - dx;
+			uint8_t pixels = 0xFF;
+			if (gx < x0)
+				pixels &= 0xFF << (x0 - gx);
+			if (gx + 8 > x1)
+				pixels &= 0xFF >> (gx + 8 - x1);
+			if (transform & COPY_TRIANGLE) {
+				// Copy pixels s + i >= y
+				int16_t first = y - s;
+				if (first >= 8)
+					continue;
+				if (first > 0)
+					pixels &= 0xFF << first;
+			}
+			const uint8_t* bitRow = row;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++, bitRow += copyRowBytes)
+					planeBits[8 * c + p] = (transform & COPY_FLIP_X) ? reverse8(extractBits(bitRow, copyWidth - 8 - s, copyWidth, false)) : extractBits(bitRow, s, copyWidth, false);
+			writeGroup(_edit_buffer, gx, py, planeBits, pixels);
+		}
+	}
+}
+
+void ESP8266RGBMatrix::dim(uint8_t scale) {
+	if (!_isBegin || (scale == 255))
+		return;
+	// Scaling doesn't depend on the pixel position : the planes are processed as they are, a byte of each
+	// plane holding the bits of the same 8 values
+	uint8_t lut[256] = {0};
+	uint16_t levels = 1 << _colorDepth;
+	for (uint16_t v = 0; v < levels; v++)
+		lut[v] = (v * (scale + 1)) >> 8;
+
+	// Power of two scale : each plane takes a higher one
+	uint8_t shift = 0;
+	for (uint8_t k = 1; (k <= _colorDepth) && !shift; k++) {
+		bool match = true;
+		for (uint16_t v = 0; (v < levels) && match; v++)
+			match = lut[v] == (v >> k);
+		if (match)
+			shift = k;
+	}
+	if (shift && !(_bufferSize & 3)) {
+		for (uint8_t p = 0; p + shift < _colorDepth; p++)
+			copyWords(_edit_buffer + p * _bufferSize, _edit_buffer + (p + shift) * _bufferSize, _bufferSize);
+		clearWords(_edit_buffer + (_colorDepth - shift) * _bufferSize, shift * _bufferSize);
+		return;
+	}
+
+	// Else decode, scale and encode again 4 bytes of each plane at a time, black words are skipped
+	uint8_t planes[8] = {0};
+	if (!(_bufferSize & 3)) {
+		for (uint32_t offset = 0; offset < _bufferSize; offset += 4) {
+			uint32_t words[8];
+			uint32_t any = 0;
+			for (uint8_t p = 0; p < _colorDepth; p++)
+				any |= words[p] = *(uint32_t*)(_edit_buffer + p * _bufferSize + offset);
+			if (!any)
+				continue;
+			for (uint8_t p = 0; p < _colorDepth; p++)
+				words[p] = 0;
+			for (uint8_t lane = 0; lane < 32; lane += 8) {
+				for (uint8_t p = 0; p < _colorDepth; p++)
+					planes[p] = *(uint32_t*)(_edit_buffer + p * _bufferSize + offset) >> lane;
+				scalePlanes(planes, lut);
+				for (uint8_t p = 0; p < _colorDepth; p++)
+					words[p] |= (uint32_t)planes[p] << lane;
+			}
+			for (uint8_t p = 0; p < _colorDepth; p++)
+				*(uint32_t*)(_edit_buffer + p * _bufferSize + offset) = words[p];
+		}
+		return;
+	}
+	for (uint32_t offset = 0; offset < _bufferSize; offset++) {
+		for (uint8_t p = 0; p < _colorDepth; p++)
+			planes[p] = readByte(_edit_buffer, p * _bufferSize + offset);
+		scalePlanes(planes, lut);
+		for (uint8_t p = 0; p < _colorDepth; p++)
+			writeBits(_edit_buffer, p * _bufferSize + offset, planes[p], 0xFF);
+	}
+}
+
+void ESP8266RGBMatrix::blendFrames(const uint8_t* from, const uint8_t* to, uint8_t amount) {
+	if (!_isBegin || !from || !to)
+		return;
+	// As dim() : the same byte of each plane holds the bits of the same 8 values in both frames
+	uint16_t weight = amount + (amount >> 7);
+	uint8_t planes[8] = {0};
+	uint8_t other[8] = {0};
+	if (!(_bufferSize & 3)) {
+		for (uint32_t offset = 0; offset < _bufferSize; offset += 4) {
+			uint32_t words[8];
+			bool same = true;
+			for (uint8_t p = 0; p < _colorDepth; p++) {
+				words[p] = *(const uint32_t*)(from + p * _bufferSize + offset);
+				same &= words[p] == *(const uint32_t*)(to + p * _bufferSize + offset);
+			}
+			// Nothing to blend where both frames are the same
+			if (!same) {
+				for (uint8_t lane = 0; lane < 32; lane += 8) {
+					for (uint8_t p = 0; p < _colorDepth; p++) {
+						planes[p] = *(const uint32_t*)(from + p * _bufferSize + offset) >> lane;
+						other[p] = *(const uint32_t*)(to + p * _bufferSize + offset) >> lane;
+					}
+					blendPlanes(planes, other, weight);
+					for (uint8_t p = 0; p < _colorDepth; p++)
+						words[p] = (words[p] & ~(0xFFUL << lane)) | ((uint32_t)planes[p] << lane);
+				}
+			}
+			for (uint8_t p = 0; p < _colorDepth; p++)
+				*(uint32_t*)(_edit_buffer + p * _bufferSize + offset) = words[p];
+		}
+		return;
+	}
+	for (uint32_t offset = 0; offset < _bufferSize; offset++) {
+		for (uint8_t p = 0; p < _colorDepth; p++) {
+			planes[p] = readByte(from, p * _bufferSize + offset);
+			other[p] = readByte(to, p * _bufferSize + offset);
+		}
+		blendPlanes(planes, other, weight);
+		for (uint8_t p = 0; p < _colorDepth; p++)
+			writeBits(_edit_buffer, p * _bufferSize + offset, planes[p], 0xFF);
+	}
+}
+
+void ESP8266RGBMatrix::rasterGroup(int16_t x, int16_t y, uint8_t pixels, uint8_t op, const uint8_t* source, const uint8_t* values) {
+	// Same pixels of both buffers are at the same place : the bytes are combined as they are, under the pixels mask
+	const groupStruct* group = _groupMapValid ? &_group_map[y * ((_width + 7) / 8) + (x >> 3)] : nullptr;
+	if (!group || (group->cfg == 0xFF)) {
+		for (uint8_t i = 0; i < 8; i++) {
+			uint32_t offset;
+			uint8_t bit;
+			if (!(pixels & (1 << i)) || !mapPixel(x + i, y, offset, bit))
+				continue;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++) {
+					uint32_t o = p * _bufferSize + offset - c * _patternColorBytes;
+					uint8_t s = source ? readByte(source, o) : ((values[c] >> p) & 0x01) ? 0xFF : 0x00;
+					writeBits(_edit_buffer, o, rasterOp(op, readByte(_edit_buffer, o), s), 1 << bit);
+				}
+		}
+		return;
+	}
+
+	uint8_t mask_lo = placeNibble(pixels & 0x0F, group->cfg & 0x0F);
+	uint8_t mask_hi = placeNibble(pixels >> 4, group->cfg >> 4);
+	if (!group->offset_hi) {
+		mask_lo |= mask_hi;
+		mask_hi = 0;
+	}
+	for (uint8_t c = 0; c < 3; c++) {
+		uint32_t offset = group->offset - c * _patternColorBytes;
+		for (uint8_t p = 0; p < _colorDepth; p++, offset += _bufferSize) {
+			uint8_t s = ((values[c] >> p) & 0x01) ? 0xFF : 0x00;
+			if (mask_lo)
+				writeBits(_edit_buffer, offset, rasterOp(op, readByte(_edit_buffer, offset), source ? readByte(source, offset) : s), mask_lo);
+			if (mask_hi) {
+				uint32_t o = offset + group->offset_hi;
+				writeBits(_edit_buffer, o, rasterOp(op, readByte(_edit_buffer, o), source ? readByte(source, o) : s), mask_hi);
+			}
+		}
+	}
+}
+
+void ESP8266RGBMatrix::raster(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* mask, uint8_t op, const uint8_t* source, const uint8_t* values) {
+	if (!_isBegin)
+		return;
+	int16_t x0 = x < 0 ? 0 : x;
+	int16_t y0 = y < 0 ? 0 : y;
+	int16_t x1 = x + width > _width ? _width : x + width;
+	int16_t y1 = y + height > _height ? _height : y + height;
+	if ((x0 >= x1) || (y0 >= y1))
+		return;
+
+	// The whole panel without mask is position independent : word operations over every plane, when the color
+	// bits of each plane are the same for r, g and b
+	if (!mask && !x0 && !y0 && (x1 == _width) && (y1 == _height) && !(_bufferSize & 3)) {
+		bool uniform = true;
+		for (uint8_t p = 0; (p < _colorDepth) && !source; p++)
+			uniform &= (((values[0] ^ values[1]) | (values[0] ^ values[2])) & (1 << p)) == 0;
+		if (uniform) {
+			for (uint8_t p = 0; p < _colorDepth; p++) {
+				uint32_t* d = (uint32_t*)(_edit_buffer + p * _bufferSize);
+				const uint32_t* s = source ? (const uint32_t*)(source + p * _bufferSize) : nullptr;
+				uint32_t k = ((values[0] >> p) & 0x01) ? 0xFFFFFFFF : 0;
+				for (uint32_t i = 0; i < _bufferSize / 4; i++)
+					d[i] = rasterOp(op, d[i], s ? s[i] : k);
+			}
+			return;
+		}
+	}
+
+	if (!_groupMapValid)
+		initGroupMap();
+	uint16_t maskBytes = (width + 7) / 8;
+	for (int16_t py = y0; py < y1; py++) {
+		for (int16_t gx = x0 & ~7; gx < x1; gx += 8) {
+			uint8_t pixels = 0xFF;
+			if (gx < x0)
+				pixels &= 0xFF << (x0 - gx);
+			if (gx + 8 > x1)
+				pixels &= 0xFF >> (gx + 8 - x1);
+			if (mask) {
+				const uint8_t* row = mask + (py - y) * maskBytes;
+				for (uint8_t i = 0; i < 8; i++) {
+					int16_t m = gx + i - x;
+					if ((pixels & (1 << i)) && !(pgm_read_byte(row + m / 8) & (0x80 >> (m & 7))))
+						pixels &= ~(1 << i);
+				}
+			}
+			if (pixels)
+				rasterGroup(gx, py, pixels, op, source, values);
+		}
+	}
+}
+
+void ESP8266RGBMatrix::rasterRect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint8_t op, uint8_t r, uint8_t g, uint8_t b) {
+	applyColorSettings(r, g, b);
+	uint8_t values[3] = {(uint8_t)(r >> (8 - _colorDepth)), (uint8_t)(g >> (8 - _colorDepth)), (uint8_t)(b >> (8 - _colorDepth))};
+	raster(x, y, width, height, nullptr, op, nullptr, values);
+}
+
+void ESP8266RGBMatrix::rasterMask(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* mask, uint8_t op, uint8_t r, uint8_t g, uint8_t b) {
+	applyColorSettings(r, g, b);
+	uint8_t values[3] = {(uint8_t)(r >> (8 - _colorDepth)), (uint8_t)(g >> (8 - _colorDepth)), (uint8_t)(b >> (8 - _colorDepth))};
+	raster(x, y, width, height, mask, op, nullptr, values);
+}
+
+void ESP8266RGBMatrix::rasterBuffer(int16_t x, int16_t y, uint16_t width, uint16_t height, uint8_t op) {
+	if (!_doubleBuffer)
+		return;
+	uint8_t values[3] = {0, 0, 0};
+	raster(x, y, width, height, nullptr, op, _display_buffer, values);
+}
+
 uint8_t ESP8266RGBMatrix::getPixel(int8_t x, int8_t y) {
 	return (0);  //PxMATRIX_buffer[x+ (y/8)*LCDWIDTH] >> (y%8)) & 0x1;
 }
 
 bool ESP8266RGBMatrix::enable() {
+	return enable(false);
+}
+
+bool ESP8266RGBMatrix::enable(bool nmi) {
 	if (!_isBegin){
 		DEBUGLOG("Must call begin() before enable()");
 		return false;
 	}
+	timer1_disable();
+	_nmi = nmi;
+	_cyclesPerTick = ESP.getCpuFreqMHz() / 5;	// Timer1 runs at 5MHz with TIM_DIV16
 	// Premier appel pour initiliser les pointeurs
 	// Timer1 automaticly adjuste ticks
 	refresh();
-	timer1_isr_init();
-	timer1_attachInterrupt(ESP8266RGBMatrix::refreshCallback);
+	_jitterArmed = false;	// The first period is set by timer1_write() below, not measured
+	if (_nmi){
+		// The NMI cannot be masked: WiFi and SDK interrupts no longer delay the slices
+		// but refreshNMICallback() and everything it calls must stay in IRAM and never call the SDK
+		NmiTimSetFunc(ESP8266RGBMatrix::refreshNMICallback);
+		ETS_FRC1_INTR_ENABLE();
+	}
+	else {
+		timer1_isr_init();
+		timer1_attachInterrupt(ESP8266RGBMatrix::refreshCallback);
+	}
 	timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);	 //TIM_DIV16 5MHz (5 ticks/us - 1677721.4 us max)
 	timer1_write(50);  // 50 ticks = 5*10 us = 50us
+	_isEnabled = true;
 	return true;
 }
 
 void ESP8266RGBMatrix::disable() {
 	timer1_disable();
+	_isEnabled = false;
+	if (_nmi){
+		// Route FRC1 back to the normal level 1 interrupt
+		ESP8266_DREG(0x00) &= ~1;
+		_nmi = false;
+	}
 	GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, _mask_OE);	//Force panel off
 }
 
-void ESP8266RGBMatrix::refreshCallback() {
+void RGBMATRIX_IRAM ESP8266RGBMatrix::refreshCallback() {
+	RGBMatrix.refresh();
+}
+
+void RGBMATRIX_IRAM ESP8266RGBMatrix::refreshNMICallback() {
 	RGBMatrix.refresh();
 }
 
+void ESP8266RGBMatrix::getJitter(refreshJitter &jitter) {
+	// The interrupt may update the counters while copying, retry until the copy is consistent
+	do {
+		jitter = _jitter;
+	} while (jitter.samples != ((volatile refreshJitter*)&_jitter)->samples);
+}
+
+void ESP8266RGBMatrix::getStats(refreshStats &stats) {
+	do {
+		stats = _stats;
+	} while (stats.interrupts != ((volatile refreshStats*)&_stats)->interrupts);
+	stats.elapsedMs = millis() - _statsStart;
+	stats.avgCycles = stats.interrupts ? stats.sumCycles / stats.interrupts : 0;
+	uint64_t elapsedCycles = (uint64_t)stats.elapsedMs * ESP.getCpuFreqMHz() * 1000;
+	stats.cpuLoad = elapsedCycles ? (float)stats.sumCycles / elapsedCycles : 0;
+}
+
+void ESP8266RGBMatrix::resetStats() {
+	// Counters updated by the interrupt are cleared by the interrupt itself
+	_stats.swaps = 0;
+	_stats.droppedSwaps = 0;
+	_swapFrame = 0;
+	_statsStart = millis();
+	_statsReset = true;
+}
+
+void ESP8266RGBMatrix::resetJitter() {
+	// Cleared by the interrupt itself to avoid racing with it
+	_jitterReset = true;
+}
+
 void ESP8266RGBMatrix::refreshTest(){
 	if (!_isBegin){
 		DEBUGLOG("Must call begin() before enable()");
@@ -544,10 +1479,12 @@ void ESP8266RGBMatrix::refreshTest(){
 	uint32_t sumV = 0;
 	uint16_t minV = 0xFFFF;
 	uint16_t maxV = 0;
-	for(int i = 0; i<_rowPattern*_colorDepth; i++){
+	for(int i = 0; i<_rowPattern*(_colorDepth-_burstLayers); i++){
+		uint32_t savedPS = xt_rsil(15);
 		uint32_t deb = asm_ccount();
 		refresh();
 		uint32_t delta = asm_ccount() - deb;
+		xt_wsr_ps(savedPS);
 		sumV+=delta;
 		if (delta==minV)
 			DEBUGLOG(".");
@@ -559,30 +1496,109 @@ void ESP8266RGBMatrix::refreshTest(){
 	DEBUGLOG("\r\nMin=%d\tMax=%d\tSum=%d\r\n",minV,maxV,sumV);
 }
 
-inline void ESP8266RGBMatrix::refresh() {
+inline void RGBMATRIX_IRAM ESP8266RGBMatrix::refresh() {
 	//Min=200	Max=215	Sum=19612
+	// Runs as a level 1 interrupt or as a NMI : no SDK call, no interrupt masking, IRAM only
+
+	// Jitter : the timer restarts counting when T1L is written, compare with the programmed period
+	uint32_t entry = asm_ccount();
+	if (_jitterReset){
+		_jitterReset = false;
+		_jitter.samples = 0;
+		_jitter.minDelta = INT32_MAX;
+		_jitter.maxDelta = INT32_MIN;
+		_jitter.sumAbsDelta = 0;
+	}
+	else if (_jitterArmed){
+		int32_t delta = (int32_t)(entry - _jitterStamp) - _jitterExpected;
+		if (delta < _jitter.minDelta)	_jitter.minDelta = delta;
+		if (delta > _jitter.maxDelta)	_jitter.maxDelta = delta;
+		_jitter.sumAbsDelta += delta < 0 ? -delta : delta;
+		_jitter.samples++;
+	}
+
+	if (_statsReset){
+		_statsReset = false;
+		_stats.interrupts = 0;
+		_stats.slices = 0;
+		_stats.overruns = 0;
+		_stats.maxCycles = 0;
+		_stats.sumCycles = 0;
+		_stats.frames = 0;
+	}
+	// T1L was shorter than the SPI shift of the previous slice
+	if (SPI1CMD & SPIBUSY){
+		_stats.overruns++;
+		while (SPI1CMD & SPIBUSY) {}
+	}
 
-	noInterrupts();
+	// _display_layer/_display_row is the slice waiting in the panel shift registers
+	uint8_t layer = _display_layer;
 	GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, _mask_OE);
-	if (_display_layer == 0)
+	if (layer == 0)
 		GPIO_REG_WRITE(_muxSeq[_display_row].cmd, _muxSeq[_display_row].val);
-	GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, _mask_LAT);
-	GPIO_REG_WRITE(GPIO_OUT_W1TC_ADDRESS, _mask_LAT + _mask_OE);
+	for (;;) {
+		GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, _mask_LAT);
+		GPIO_REG_WRITE(GPIO_OUT_W1TC_ADDRESS, _mask_LAT + _mask_OE);
+		uint32_t start = asm_ccount();
+
+		_stats.slices++;
+		_display_layer++;
+		if (_display_layer == _colorDepth) {
+			_display_layer = 0;
+			_display_row = (_display_row + 1) & (_rowPattern-1);
+			_display_buffer_pos = _display_buffer + _muxSeq[_display_row].offset;
+			if (_display_row == 0)
+				_stats.frames++;
+		}
+		else
+			_display_buffer_pos += _bufferSize;
+
+		// Word copy : memcpy may not be in IRAM. Rows start on a 2 byte boundary when width/8 is odd,
+		// they are then read with aligned loads and a funnel shift (a misaligned load is an exception)
+		volatile uint32_t* spi = &SPI1W0;
+		uint8_t words = (_sendBufferSize + 3) / 4;
+		uint8_t shift = ((uintptr_t)_display_buffer_pos & 3) * 8;
+		const uint32_t* src = (const uint32_t*)((uintptr_t)_display_buffer_pos & ~3);
+		if (!shift) {
+			for (uint8_t i = 0; i < words; i++)
+				spi[i] = src[i];
+		}
+		else {
+			// The bytes past the row in the last word are not sent, the next word is not read
+			uint32_t lo = src[0];
+			for (uint8_t i = 0; i < words - 1; i++) {
+				uint32_t hi = src[i + 1];
+				spi[i] = (lo >> shift) | (hi << (32 - shift));
+				lo = hi;
+			}
+			spi[words - 1] = lo >> shift;
+		}
+		SPI1CMD |= SPIBUSY;
 
-	_display_layer++;
-	if (_display_layer == _colorDepth) {
-		_display_layer = 0;
-		_display_row = (_display_row + 1) & (_rowPattern-1);
-		_display_buffer_pos = _display_buffer + _muxSeq[_display_row].offset;
-	}
-	else
-		_display_buffer_pos += _bufferSize;
+		if (layer >= _burstLayers)
+			break;
 
-	memcpy((void *)&SPI1W0, _display_buffer_pos , _sendBufferSize);
-	SPI1CMD |= SPIBUSY;
+		// Sub tick slice : the next slice is shifted while this one is shown
+		// (_burstLayers < _colorDepth, so the next slice is always on the same row)
+		while ((uint32_t)(asm_ccount() - start) < _burstCycles[layer]) {}
+		GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, _mask_OE);
+		while (SPI1CMD & SPIBUSY) {}
+		layer++;
+	}
 
-	T1L = _showTicks*(1<<_display_layer);
-	interrupts();
+	// The latched slice is shown until the next interrupt
+	uint32_t ticks = (uint32_t)_showTicks << layer;
+	T1L = ticks;
+	_jitterStamp = asm_ccount();
+	_jitterExpected = ticks * _cyclesPerTick;
+	_jitterArmed = true;
+
+	uint32_t cycles = _jitterStamp - entry;
+	if (cycles > _stats.maxCycles)
+		_stats.maxCycles = cycles;
+	_stats.sumCycles += cycles;
+	_stats.interrupts++;
 }
 
 ESP8266RGBMatrix RGBMatrix;
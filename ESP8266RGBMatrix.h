@@ -19,6 +19,13 @@
 #endif
 
 // Helper
+// Code called from the refresh interrupt must live in IRAM (mandatory for the NMI mode)
+#ifdef IRAM_ATTR
+#define RGBMATRIX_IRAM IRAM_ATTR
+#else
+#define RGBMATRIX_IRAM ICACHE_RAM_ATTR
+#endif
+
 #ifndef _BV
 #define _BV(x) (1 << (x))
 #endif
@@ -29,8 +36,14 @@
 //#include "Arduino.h"
 
 /* asm-helpers */
+#ifndef RGBMATRIX_HOST
 static inline int32_t asm_ccount(void) {
     int32_t r; asm volatile ("rsr %0, ccount" : "=r"(r)); return r; }
+#else
+// Desktop build (extras/host), no cycle counter
+static inline int32_t asm_ccount(void) {
+    return ESP.getCycleCount(); }
+#endif
 
 // Specifies what blocking pattern the panel is using
 // |AB|,|DB|
@@ -60,6 +73,42 @@ enum color_orders { RRGGBB,
 					BBRRGG,
 					BBGGRR };
 
+// Where the frame buffers are allocated. BUFFER_IRAM needs the second heap of the core (MMU_IRAM_HEAP),
+// otherwise (or if it is full) the buffers stay in DRAM
+enum buffer_locations { BUFFER_DRAM,
+						BUFFER_IRAM };
+
+// Transforms of copyRect(), combined with |. The copy is transposed first, then flipped
+enum copy_transforms { COPY_FLIP_X = 0x01,
+					   COPY_FLIP_Y = 0x02,
+					   COPY_TRANSPOSE = 0x04,		// x and y swapped : the copy of a w x h area is h x w
+					   COPY_TRIANGLE = 0x08 };		// Only the copy pixels on or above its diagonal (x >= y)
+
+// Raster operations between the edit buffer bits (d) and a source (s)
+enum raster_ops { ROP_COPY,			// s
+				  ROP_OR,			// d | s
+				  ROP_AND,			// d & s
+				  ROP_XOR,			// d ^ s : XOR with white inverts, twice restores
+				  ROP_AND_NOT };	// d & ~s
+
+static inline uint32_t rasterOp(uint8_t op, uint32_t d, uint32_t s) {
+	switch (op) {
+		case ROP_COPY:		return s;
+		case ROP_OR:		return d | s;
+		case ROP_AND:		return d & s;
+		case ROP_XOR:		return d ^ s;
+		case ROP_AND_NOT:	return d & ~s;
+	}
+	return d;
+}
+
+// RGB565 to RGB888, each component scaled to the full 0 - 255 range with rounding
+static inline void rgb565to888(uint16_t color, uint8_t &r, uint8_t &g, uint8_t &b) {
+	r = ((((color >> 11) & 0x1F) * 527) + 23) >> 6;
+	g = ((((color >> 5) & 0x3F) * 259) + 33) >> 6;
+	b = (((color & 0x1F) * 527) + 23) >> 6;
+}
+
 class ESP8266RGBMatrix {
 public:
 	ESP8266RGBMatrix();
@@ -68,31 +117,106 @@ public:
 	void setGPIO(uint8_t gpio_OE, uint8_t gpio_LAT, uint8_t gpio_A, uint8_t gpio_B, uint8_t gpio_C, uint8_t gpio_D, uint8_t gpio_E);
 	void begin(uint16_t width, uint16_t height, uint8_t colorDepth);
 	void begin(uint16_t width, uint16_t height, uint8_t colorDepth, bool doubleBuffer);
+	// Change the layout at runtime, the refresh is paused meanwhile and the frame buffers are reused (content is cleared)
+	bool reconfigure(uint8_t colorDepth, bool doubleBuffer, uint8_t panels_width, scan_patterns scan_pattern);
 
 	void disable();
 	bool enable();
-	static inline void refreshCallback();
+	bool enable(bool nmi);								// nmi = true runs the refresh on the FRC1 NMI vector (not delayed by WiFi/SDK interrupts)
+	static void refreshCallback();
+	static void refreshNMICallback();
 	inline void refresh();
 	void refreshTest();
 
+	// Refresh timing measured at each timer interrupt entry, in CPU cycles, relative to the programmed period
+	struct refreshJitter {
+		uint32_t samples;		// Number of measured periods
+		int32_t minDelta;		// Earliest entry (negative = early)
+		int32_t maxDelta;		// Latest entry
+		uint64_t sumAbsDelta;	// Sum of |delta|, mean jitter = sumAbsDelta / samples
+	};
+	void getJitter(refreshJitter &jitter);
+	void resetJitter();
+
+	// Refresh health counters, always on
+	struct refreshStats {
+		uint32_t interrupts;	// Refresh interrupts
+		uint32_t slices;		// Slices shown (timer and sub tick ones)
+		uint32_t overruns;		// SPI still shifting at interrupt entry (T1L shorter than the shift)
+		uint32_t maxCycles;		// Longest interrupt in CPU cycles
+		uint64_t sumCycles;		// Total interrupt time in CPU cycles
+		uint32_t frames;		// Frames completed
+		uint32_t swaps;			// showBuffer() calls swapping the buffers (0 in single buffer mode)
+		uint32_t droppedSwaps;	// Swaps done before the previous frame was entirely shown
+		uint32_t elapsedMs;		// Time since resetStats() (filled by getStats())
+		uint32_t avgCycles;		// sumCycles / interrupts (filled by getStats())
+		float cpuLoad;			// Part of the CPU used by the refresh, 0..1 (filled by getStats())
+	};
+	void getStats(refreshStats &stats);
+	void resetStats();
+
 	void setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);
+	// Bulk encoding of count pixels of row y from x : pixels are sliced into the bitplanes 8 at a time
+	void writeRGB888(int16_t x, int16_t y, const uint8_t* rgb, uint16_t count);
+	void writeRGB565(int16_t x, int16_t y, const uint16_t* rgb565, uint16_t count);
 	uint8_t getPixel(int8_t x, int8_t y);                // Does nothing for now (always returns 0)
-	void showBuffer();
+	void showBuffer();									// Refused while drawing is redirected
 	void copyBuffer(bool reverse);
 	void clearDisplay();
 	void clearDisplay(bool selected_buffer);
+	// Drawing (setPixel(), the bulk encoders, clearDisplay(), the bitplane operations...) goes to frame, an encoded
+	// frame of getFrameSize() bytes (word aligned), until setDrawTarget(nullptr) goes back to the edit buffer
+	void setDrawTarget(uint8_t* frame);
+	bool isDrawRedirected()								{return _drawRedirected;};
+	// Move the edit buffer content within the bitplanes : rows by dx pixels (right if > 0), columns by dy pixels
+	// (down if > 0). The pixels moved in are black, or the ones moved out on the other side with wrap
+	void shiftRows(int16_t dx, bool wrap = false);
+	void shiftColumns(int16_t dy, bool wrap = false);
+	// Copy the width x height area at (sx, sy) of the edit buffer to (dx, dy) within the bitplanes, the areas may overlap
+	void copyRect(int16_t sx, int16_t sy, uint16_t width, uint16_t height, int16_t dx, int16_t dy, uint8_t transform = 0);
+	void mirrorX()										{copyRect(0, 0, _width / 2, _height, (_width + 1) / 2, 0, COPY_FLIP_X);};	// Right half from the left one
+	void mirrorY()										{copyRect(0, 0, _width, _height / 2, 0, (_height + 1) / 2, COPY_FLIP_Y);};	// Bottom half from the top one
+	void dim(uint8_t scale);				// Every color of the edit buffer times (scale + 1) / 256, as FastLED nscale8()
+	void kaleidoscope()									{mirrorX(); mirrorY();};	// Top left quarter mirrored to the 3 others
+	// Edit buffer = from * (256 - amount) / 256 + to * amount / 256 for every color, from and to are encoded frames
+	// of getFrameSize() bytes (amount 255 gives to)
+	void blendFrames(const uint8_t* from, const uint8_t* to, uint8_t amount);
+	// Raster operations (raster_ops) on an area of the edit buffer bitplanes with a color, a color where a 1 bit mask
+	// is set (drawBitmap() format, RAM or PROGMEM), or the same area of the displayed buffer (double buffering)
+	void rasterRect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint8_t op, uint8_t r, uint8_t g, uint8_t b);
+	void rasterMask(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* mask, uint8_t op, uint8_t r, uint8_t g, uint8_t b);
+	void rasterBuffer(int16_t x, int16_t y, uint16_t width, uint16_t height, uint8_t op);
 
+	void setSubTickSlices(bool enable);					// Emit the LSB slices shorter than the SPI shift inside one interrupt (default is true)
 	void setFramesPerSec(uint8_t frames)				{_framesPerSec = frames>1?frames:1;};
 	void setBrightness(uint8_t brightness);			// Set the brightness of the panels (default is 255)
-	void setRotate(bool rotate)							{_rotate = rotate;};  					// Rotate display
-	void setFlip(bool flip)								{_flip = flip;};      					// Flip display
+	void setRotate(bool rotate)							{_rotate = rotate; _groupMapValid = false;};  					// Rotate display
+	void setFlip(bool flip)								{_flip = flip; _groupMapValid = false;};      					// Flip display
 	void setColorOrder(color_orders color_order)		{_color_order = color_order;};			// Set the color order
-	void setScanPattern(scan_patterns scan_pattern)		{_scan_pattern = scan_pattern;};		// Set the multiplex pattern {LINE, ZIGZAG, ZAGGIZ, WZAGZIG, VZAG, WZAGZIG2} (default is LINE)
-	void setBlockPattern(block_patterns block_pattern)	{_block_pattern = block_pattern;};		// Set the block pattern {ABCD, DBCA} (default is ABCD)
+	void setScanPattern(scan_patterns scan_pattern)		{_scan_pattern = scan_pattern; _groupMapValid = false;};		// Set the multiplex pattern {LINE, ZIGZAG, ZAGGIZ, WZAGZIG, VZAG, WZAGZIG2} (default is LINE)
+	void setBlockPattern(block_patterns block_pattern)	{_block_pattern = block_pattern; _groupMapValid = false;};		// Set the block pattern {ABCD, DBCA} (default is ABCD)
 	void setColorOffset(uint8_t r, uint8_t g, uint8_t b);// Control the minimum color values that result in an active pixel
-	void setPanelsWidth(uint8_t panels)					{_panels_width = panels;};				// Set the number of panels that make up the display area width (default is 1)
+	uint16_t getWidth()									{return _width;};
+	uint16_t getHeight()								{return _height;};
+	uint8_t getColorDepth()								{return _colorDepth;};
+
+	// Raw access to the bitplanes, for pre-encoded content. The layout depends on the geometry,
+	// the color depth and every setting above : check getLayoutSignature() before copying
+	uint8_t* getEditBuffer()							{return _edit_buffer;};
+	uint32_t getFrameSize()								{return _colorDepth * _bufferSize;};
+	uint32_t getLayoutSignature();
+	bool isDoubleBuffer()								{return _doubleBuffer;};
+	uint32_t getFrameCount()							{return ((volatile refreshStats*)&_stats)->frames;};	// Frames completed by the refresh
+	void setPanelsWidth(uint8_t panels)					{_panels_width = panels; _groupMapValid = false;};				// Set the number of panels that make up the display area width (default is 1)
+	void setBufferLocation(buffer_locations location)	{_bufferLocation = location;};			// Set where begin() allocates the frame buffers {BUFFER_DRAM, BUFFER_IRAM} (default is BUFFER_DRAM)
+	buffer_locations getBufferLocation()				{return _arenaLocation;};				// Where the frame buffers actually are
 
 private:
+	friend class RGBMatrixSprite;
+	friend class RGBMatrixIndexed;
+	friend class RGBMatrixLife;
+	friend class RGBMatrixTransition;
+
 	uint16_t _width;
 	uint16_t _height;
 	uint8_t _colorDepth;
@@ -111,6 +235,8 @@ private:
 	uint8_t _panels_width;
 
 	bool _isBegin;
+	bool _isEnabled;
+	bool _nmi;						// Refresh attached to the NMI vector
 	uint8_t _muxBits;
 	uint8_t _rowPattern;
 	uint32_t _bufferSize;
@@ -126,22 +252,106 @@ private:
 	uint16_t _mask_D;
 	uint16_t _mask_E;
 	uint16_t _showTicks;
+	uint8_t _cyclesPerTick;			// CPU cycles per timer1 tick (TIM_DIV16)
+	bool _subTickSlices;
+	uint8_t _burstLayers;			// Number of LSB layers emitted back to back in one interrupt
+	uint32_t _burstCycles[8];		// On time of these layers in CPU cycles
+
+	// Jitter measurement (updated from the interrupt, read with getJitter())
+	volatile bool _jitterReset;
+	bool _jitterArmed;
+	uint32_t _jitterStamp;			// ccount just after T1L was written
+	int32_t _jitterExpected;		// Programmed period in cycles
+	refreshJitter _jitter;
+
+	// Health counters (interrupt side cleared by the interrupt on _statsReset)
+	volatile bool _statsReset;
+	refreshStats _stats;
+	uint32_t _swapFrame;			// _stats.frames at the last showBuffer()
+	uint32_t _statsStart;			// millis() at the last resetStats()
 
 	// Holds some pre-computed values for faster pixel drawing
 	uint32_t* _row_offset;
+	uint16_t _rowOffsetSize;		// Allocated entries, only grows
+
+	// Bitplane position of each group of 8 pixels (x multiple of 8), built on the first bulk encoding
+	struct groupStruct {
+		uint16_t offset;			// Red byte of pixels 0-3 in plane 0
+		int8_t offset_hi;			// Byte of pixels 4-7, relative to offset
+		uint8_t cfg;				// Position of pixels 0-3 (low nibble) and 4-7 (high nibble) : first bit + 8 if reversed
+	};								// 0xFF : the layout splits this group, pixels are set one by one
+	groupStruct* _group_map;
+	uint32_t _groupMapSize;
+	bool _groupMapValid;
 
 	//Gestion des buffers
+	uint8_t* _arena;				// Single allocation holding _buffer and _buffer2
+	uint32_t _arenaSize;
+	buffer_locations _arenaLocation;
+	buffer_locations _arenaRequest;	// _bufferLocation when the arena was allocated (_arenaLocation differs after a fallback)
+	buffer_locations _bufferLocation;
 	uint8_t* _buffer;
 	uint8_t* _buffer2;
 	uint8_t* _display_buffer;
 	uint8_t* _display_buffer_pos;
 	uint8_t* _edit_buffer;
 	bool _active_buffer;
+	bool _drawRedirected;			// _edit_buffer set by setDrawTarget()
+	uint8_t* _scratch;				// Work area of shiftRows(), shiftColumns() and copyRect(), only grows
+	uint32_t _scratchSize;
+
+	// The frame buffers may be in IRAM, which only supports 32 bits accesses :
+	// they are always cleared and copied by words (sizes are padded to 4 bytes)
+	static inline void clearWords(uint8_t* dst, uint32_t size) {
+		uint32_t* d = (uint32_t*)dst;
+		for (uint32_t i = 0; i < (size + 3) / 4; i++)
+			d[i] = 0;
+	}
+
+	static inline void copyWords(uint8_t* dst, const uint8_t* src, uint32_t size) {
+		uint32_t* d = (uint32_t*)dst;
+		const uint32_t* s = (const uint32_t*)src;
+		for (uint32_t i = 0; i < (size + 3) / 4; i++)
+			d[i] = s[i];
+	}
+
+	// Same for bits, always changed through their word
+	static inline void writeBit(uint8_t* buffer, uint32_t offset, uint8_t bit, bool value) {
+		uint32_t* word = (uint32_t*)(buffer + (offset & ~3));
+		uint32_t mask = 1 << (((offset & 3) << 3) + bit);
+		if (value)	*word |= mask;
+		else		*word &= ~mask;
+	}
+
+	// Same for several bits of a byte
+	static inline void writeBits(uint8_t* buffer, uint32_t offset, uint8_t bits, uint8_t mask) {
+		uint32_t* word = (uint32_t*)(buffer + (offset & ~3));
+		uint8_t shift = (offset & 3) << 3;
+		*word = (*word & ~((uint32_t)mask << shift)) | ((uint32_t)(bits & mask) << shift);
+	}
+
+	// Byte of the buffer read with a 32 bits access
+	static inline uint8_t readByte(const uint8_t* buffer, uint32_t offset) {
+		return *(const uint32_t*)(buffer + (offset & ~3)) >> ((offset & 3) << 3);
+	}
+
+	bool mapPixel(int16_t x, int16_t y, uint32_t &total_offset_r, uint8_t &bit_select);
+	uint8_t* scratch(uint32_t size);
+	void applyColorSettings(uint8_t &r, uint8_t &g, uint8_t &b);
+	bool initGroupMap();
+	void readGroup(const uint8_t* buffer, int16_t x, int16_t y, uint8_t* planeBits);
+	void rasterGroup(int16_t x, int16_t y, uint8_t pixels, uint8_t op, const uint8_t* source, const uint8_t* values);
+	void raster(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* mask, uint8_t op, const uint8_t* source, const uint8_t* values);
+	void encodeGroup(uint8_t* buffer, int16_t x, int16_t y, const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t pixels);
+	void writeGroup(uint8_t* buffer, int16_t x, int16_t y, const uint8_t* planeBits, uint8_t pixels);
+	void moveGroup(int16_t sx, int16_t sy, int16_t dx, int16_t dy, uint8_t pixels);
 
+	void init(uint16_t width, uint16_t height, uint8_t colorDepth, bool doubleBuffer);
+	bool initBuffers();
 	void init_SPIBufferSize();
 	void initShowTicks();
-	void initPatternSeq();
-	void initPreIndex();
+	bool initPatternSeq();
+	bool initPreIndex();
 	void initGPIO(uint8_t muxBits, uint8_t gpio_OE, uint8_t gpio_LAT, uint8_t gpio_A, uint8_t gpio_B, uint8_t gpio_C, uint8_t gpio_D, uint8_t gpio_E);
 
 	struct muxStruct {
@@ -150,6 +360,7 @@ private:
 		uint16_t offset;
 	} ;
 	muxStruct* _muxSeq;
+	uint8_t _muxSeqSize;			// Allocated entries, only grows
 };
 
 extern ESP8266RGBMatrix RGBMatrix;
@@ -0,0 +1,49 @@
+#include "RGBMatrixAsset.h"
+
+RGBMatrixAsset::RGBMatrixAsset() {
+	_asset = nullptr;
+	memset(&_header, 0, sizeof(_header));
+	_frame = 0;
+	_lastFrame = 0;
+}
+
+bool RGBMatrixAsset::checkHeader(const rgbmatrix_asset_header &header) {
+	if ((header.magic != RGBMATRIX_ASSET_MAGIC) || (header.version != RGBMATRIX_ASSET_VERSION))
+		return false;
+	// Encoded for another panel or other settings
+	return (header.layoutSignature == RGBMatrix.getLayoutSignature()) && (header.frameSize == RGBMatrix.getFrameSize());
+}
+
+bool RGBMatrixAsset::begin(const uint8_t* asset) {
+	_asset = nullptr;
+	memcpy_P(&_header, asset, sizeof(_header));
+	if (!checkHeader(_header))
+		return false;
+	_asset = asset;
+	_frame = 0;
+	_lastFrame = millis() - _header.frameDelay;
+	return true;
+}
+
+bool RGBMatrixAsset::drawFrame(uint16_t frame) {
+	if (!_asset || (frame >= _header.frameCount))
+		return false;
+	// Flash and (maybe IRAM) frame buffer are both read/written by words
+	uint32_t words = (_header.frameSize + 3) / 4;
+	const uint32_t* src = (const uint32_t*)(_asset + sizeof(_header)) + frame * words;
+	uint32_t* dst = (uint32_t*)RGBMatrix.getEditBuffer();
+	for (uint32_t i = 0; i < words; i++)
+		dst[i] = pgm_read_dword(src + i);
+	return true;
+}
+
+bool RGBMatrixAsset::update() {
+	if (!_asset || (millis() - _lastFrame < _header.frameDelay))
+		return false;
+	_lastFrame += _header.frameDelay;
+	drawFrame(_frame);
+	RGBMatrix.showBuffer();
+	if (++_frame >= _header.frameCount)
+		_frame = 0;
+	return true;
+}
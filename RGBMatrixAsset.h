@@ -0,0 +1,43 @@
+#ifndef RGBMatrixAsset_H
+#define RGBMatrixAsset_H
+
+#include "ESP8266RGBMatrix.h"
+
+#define RGBMATRIX_ASSET_MAGIC	0x4D424752	// "RGBM"
+#define RGBMATRIX_ASSET_VERSION	1
+
+// Pre-encoded asset : this header, then frameCount frames of frameSize bytes already in the
+// bitplane layout of the driver. Everything is 32 bits aligned so frames are copied by words.
+// Generated by extras/tools/rgbmatrix_asset.cpp
+struct rgbmatrix_asset_header {
+	uint32_t magic;				// RGBMATRIX_ASSET_MAGIC
+	uint8_t version;			// RGBMATRIX_ASSET_VERSION
+	uint8_t colorDepth;
+	uint8_t rowPattern;
+	uint8_t scanPattern;
+	uint16_t width;
+	uint16_t height;
+	uint16_t frameCount;
+	uint16_t frameDelay;		// ms between two frames
+	uint32_t frameSize;			// Bytes per frame (ESP8266RGBMatrix::getFrameSize()), frames are padded to 4 bytes
+	uint32_t layoutSignature;	// ESP8266RGBMatrix::getLayoutSignature() of the encoding setup
+};
+
+class RGBMatrixAsset {
+public:
+	RGBMatrixAsset();
+	static bool checkHeader(const rgbmatrix_asset_header &header);	// Check a header against the current layout
+	bool begin(const uint8_t* asset);		// Asset in PROGMEM, false if it doesn't match the current layout
+	uint16_t getFrameCount()				{return _header.frameCount;};
+	uint16_t getFrameDelay()				{return _header.frameDelay;};
+	bool drawFrame(uint16_t frame);			// Copy a frame into the edit buffer
+	bool update();							// Draw and show the next frame when its time has come
+
+private:
+	const uint8_t* _asset;
+	rgbmatrix_asset_header _header;
+	uint16_t _frame;
+	uint32_t _lastFrame;
+};
+
+#endif /*RGBMatrixAsset_H*/
@@ -0,0 +1,65 @@
+#include "RGBMatrixCanvas.h"
+
+RGBMatrixCanvas::RGBMatrixCanvas(int16_t width, int16_t height) : Adafruit_GFX(width, height) {
+	_scrollX = 0;
+	_scrollY = 0;
+	_wrap = true;
+}
+
+bool RGBMatrixCanvas::begin() {
+	return _canvas.begin(WIDTH, HEIGHT, true);
+}
+
+// Pass 8-bit (each) R,G,B, get back 16-bit packed color
+uint16_t RGBMatrixCanvas::color565(uint8_t r, uint8_t g, uint8_t b) {
+	return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+void RGBMatrixCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+	uint8_t r, g, b;
+	rgb565to888(color, r, g, b);
+	_canvas.setPixel(x, y, r, g, b);
+}
+
+void RGBMatrixCanvas::drawPixelRGB888(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) {
+	_canvas.setPixel(x, y, r, g, b);
+}
+
+void RGBMatrixCanvas::fillScreen(uint16_t color) {
+	uint8_t r, g, b;
+	rgb565to888(color, r, g, b);
+	_canvas.fill(r, g, b);
+}
+
+void RGBMatrixCanvas::setScroll(int16_t x, int16_t y) {
+	// When wrapping the offset is kept within the canvas : a marquee scrolled for ever never overflows
+	if (_wrap) {
+		x %= (int16_t)WIDTH;
+		y %= (int16_t)HEIGHT;
+		if (x < 0)
+			x += WIDTH;
+		if (y < 0)
+			y += HEIGHT;
+	}
+	_scrollX = x;
+	_scrollY = y;
+}
+
+void RGBMatrixCanvas::draw() {
+	int16_t x = -_scrollX;
+	int16_t y = -_scrollY;
+	if (!_wrap) {
+		_canvas.draw(x, y);
+		return;
+	}
+	// Copies of the canvas around the window, the sprite clipping keeps only what is seen
+	x %= (int16_t)WIDTH;
+	y %= (int16_t)HEIGHT;
+	if (x > 0)
+		x -= WIDTH;
+	if (y > 0)
+		y -= HEIGHT;
+	for (int16_t yy = y; yy < RGBMatrix.getHeight(); yy += HEIGHT)
+		for (int16_t xx = x; xx < RGBMatrix.getWidth(); xx += WIDTH)
+			_canvas.draw(xx, yy);
+}
@@ -0,0 +1,35 @@
+#ifndef RGBMatrixCanvas_H
+#define RGBMatrixCanvas_H
+
+#include "Adafruit_GFX.h"
+#include "RGBMatrixSprite.h"
+
+// Virtual canvas larger than the panel : drawn once (Adafruit GFX text, shapes ...) and shown through
+// a window moved by setScroll(), a marquee is a scroll offset instead of a redraw per step.
+// The canvas is kept in the sprite bit rows, draw() copies the window to the edit buffer 8 pixels at
+// a time : about (width / 8 + 1) * (1 + 3 * colorDepth) * height bytes of RAM.
+class RGBMatrixCanvas : public Adafruit_GFX {
+public:
+	RGBMatrixCanvas(int16_t width, int16_t height);
+	bool begin();							// After RGBMatrix.begin(), again if the color settings change
+	void end()								{_canvas.end();};
+	uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
+	void drawPixel(int16_t x, int16_t y, uint16_t color);
+	void drawPixelRGB888(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);
+	void fillScreen(uint16_t color);
+
+	void setScroll(int16_t x, int16_t y);	// Canvas point shown at the panel top left
+	void scroll(int16_t dx, int16_t dy)		{setScroll(_scrollX + dx, _scrollY + dy);};
+	int16_t getScrollX()					{return _scrollX;};
+	int16_t getScrollY()					{return _scrollY;};
+	void setWrap(bool wrap)					{_wrap = wrap; setScroll(_scrollX, _scrollY);};	// Repeat the canvas around the window (default is true)
+	void draw();							// Copy the window to the edit buffer
+
+private:
+	RGBMatrixSprite _canvas;
+	int16_t _scrollX;
+	int16_t _scrollY;
+	bool _wrap;
+};
+
+#endif /*RGBMatrixCanvas_H*/
@@ -0,0 +1,129 @@
+#include "RGBMatrixDDP.h"
+
+RGBMatrixDDP::RGBMatrixDDP() {
+	_udp = nullptr;
+	_lastSequence = 0;
+	_frameDropped = false;
+	_carryOffset = 0;
+	resetStats();
+}
+
+bool RGBMatrixDDP::begin(UDP &udp, uint16_t port) {
+	_udp = &udp;
+	_lastSequence = 0;
+	_frameDropped = false;
+	_carryOffset = 0;
+	return udp.begin(port);
+}
+
+uint8_t RGBMatrixDDP::update() {
+	uint8_t packets = 0;
+	while (_udp && (packets < RGBMATRIX_DDP_BURST) && (_udp->parsePacket() > 0)) {
+		readPacket();
+		packets++;
+	}
+	return packets;
+}
+
+bool RGBMatrixDDP::readPacket() {
+	uint8_t header[RGBMATRIX_DDP_HEADER + 4];
+	if (_udp->read(header, RGBMATRIX_DDP_HEADER) != RGBMATRIX_DDP_HEADER) {
+		_stats.invalid++;
+		return false;
+	}
+	uint8_t flags = header[0];
+	// Queries and replies are for the discovery, not supported
+	if (((flags & RGBMATRIX_DDP_VERSION_MASK) != RGBMATRIX_DDP_VERSION_1) || (flags & (RGBMATRIX_DDP_QUERY | RGBMATRIX_DDP_REPLY | RGBMATRIX_DDP_STORAGE))
+		|| ((header[3] != RGBMATRIX_DDP_ID_DISPLAY) && header[3])) {
+		_stats.invalid++;
+		return false;
+	}
+	if ((flags & RGBMATRIX_DDP_TIMECODE) && (_udp->read(header + RGBMATRIX_DDP_HEADER, 4) != 4)) {
+		_stats.invalid++;
+		return false;
+	}
+	uint32_t offset = ((uint32_t)header[4] << 24) | ((uint32_t)header[5] << 16) | (header[6] << 8) | header[7];
+	uint16_t length = (header[8] << 8) | header[9];
+
+	// Sequence 1..15, a jump forward counts the missing packets, a jump back is a late packet :
+	// its frame may already be shown, writing it would corrupt the next one
+	uint8_t sequence = header[1] & 0x0F;
+	if (sequence && _lastSequence) {
+		uint8_t gap = (sequence + 15 - _lastSequence - 1) % 15;
+		if (gap >= 8) {
+			_stats.late++;
+			return false;
+		}
+		if (gap) {
+			_stats.dropped += gap;
+			_frameDropped = true;
+		}
+	}
+	_lastSequence = sequence;
+	_stats.packets++;
+
+	// Straight from the socket to the bitplanes, a chunk at a time
+	uint8_t chunk[RGBMATRIX_DDP_CHUNK * 3];
+	while (length) {
+		int n = _udp->read(chunk, length < sizeof(chunk) ? length : sizeof(chunk));
+		if (n <= 0) {
+			// Shorter than announced : what arrived is kept, the rest of the frame is missing
+			_frameDropped = true;
+			break;
+		}
+		writeData(offset, chunk, n);
+		offset += n;
+		length -= n;
+	}
+
+	if (flags & RGBMATRIX_DDP_PUSH) {
+		if (_frameDropped)
+			_stats.incomplete++;
+		_frameDropped = false;
+		_stats.frames++;
+		RGBMatrix.showBuffer();
+	}
+	return true;
+}
+
+void RGBMatrixDDP::writeData(uint32_t offset, const uint8_t* data, uint16_t length) {
+	// End of a pixel started by the previous read, dropped if that one is not the right one
+	while (length && (offset % 3)) {
+		if (offset == _carryOffset) {
+			_carry[offset % 3] = *data;
+			if (offset % 3 == 2)
+				writePixels(offset / 3, _carry, 1);
+			_carryOffset = offset + 1;
+		}
+		else
+			_carryOffset = 0;
+		offset++;
+		data++;
+		length--;
+	}
+	uint16_t count = length / 3;
+	writePixels(offset / 3, data, count);
+	data += count * 3;
+	offset += count * 3;
+	length -= count * 3;
+	// Start of a pixel ending in the next read
+	for (uint8_t i = 0; i < length; i++)
+		_carry[i] = data[i];
+	_carryOffset = offset + length;
+}
+
+void RGBMatrixDDP::writePixels(uint32_t index, const uint8_t* rgb, uint16_t count) {
+	uint16_t width = RGBMatrix.getWidth();
+	uint32_t y = index / width;
+	uint16_t x = index % width;
+	while (count && (y < RGBMatrix.getHeight())) {
+		uint16_t n = width - x;
+		if (n > count)
+			n = count;
+		RGBMatrix.writeRGB888(x, y, rgb, n);
+		rgb += n * 3;
+		count -= n;
+		x = 0;
+		y++;
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef RGBMatrixDDP_H
+#define RGBMatrixDDP_H
+
+#include <Udp.h>
+#include "ESP8266RGBMatrix.h"
+
+#define RGBMATRIX_DDP_PORT			4048
+
+// Header : flags, sequence (low nibble, 0 = not used), data type, destination id,
+// data offset in bytes (big endian 32 bits), data length (big endian 16 bits), then a 32 bits timecode if flagged
+#define RGBMATRIX_DDP_HEADER		10
+#define RGBMATRIX_DDP_VERSION_MASK	0xC0
+#define RGBMATRIX_DDP_VERSION_1		0x40
+#define RGBMATRIX_DDP_TIMECODE		0x10
+#define RGBMATRIX_DDP_STORAGE		0x08
+#define RGBMATRIX_DDP_REPLY			0x04
+#define RGBMATRIX_DDP_QUERY			0x02
+#define RGBMATRIX_DDP_PUSH			0x01
+#define RGBMATRIX_DDP_ID_DISPLAY	1
+
+// Packets handled by one update(), bounds the time spent out of loop()
+#ifndef RGBMATRIX_DDP_BURST
+#define RGBMATRIX_DDP_BURST 8
+#endif
+
+// Pixels read from the socket at once (multiple of 8 : one bulk encoding group)
+#ifndef RGBMATRIX_DDP_CHUNK
+#define RGBMATRIX_DDP_CHUNK 64
+#endif
+
+// DDP (Distributed Display Protocol) receiver : RGB 8 bits pixels, row major from the top left one.
+// The payload is read a chunk at a time and encoded straight into the edit buffer with writeRGB888(),
+// a frame can span any number of packets and is shown by the packet with the PUSH flag.
+// Senders should send whole frames : with double buffering the edit buffer holds an older frame.
+class RGBMatrixDDP {
+public:
+	struct ddpStats {
+		uint32_t packets;		// Packets accepted
+		uint32_t frames;		// Frames shown (PUSH)
+		uint32_t dropped;		// Packets missing in the sequence
+		uint32_t late;			// Packets arrived after a later one, ignored (also counted as dropped)
+		uint32_t incomplete;	// Frames shown with dropped packets
+		uint32_t invalid;		// Packets not understood
+	};
+
+	RGBMatrixDDP();
+	bool begin(UDP &udp, uint16_t port = RGBMATRIX_DDP_PORT);
+	uint8_t update();						// Call from loop(), returns the packets handled
+	void getStats(ddpStats &stats)			{stats = _stats;};
+	void resetStats()						{memset(&_stats, 0, sizeof(_stats));};
+
+private:
+	bool readPacket();
+	void writeData(uint32_t offset, const uint8_t* data, uint16_t length);
+	void writePixels(uint32_t index, const uint8_t* rgb, uint16_t count);
+
+	UDP* _udp;
+	uint8_t _lastSequence;
+	bool _frameDropped;
+	uint8_t _carry[3];						// Pixel split between two reads or two packets
+	uint32_t _carryOffset;					// Data offset following the carried bytes
+	ddpStats _stats;
+};
+
+#endif /*RGBMatrixDDP_H*/
@@ -0,0 +1,145 @@
+#include "RGBMatrixDelta.h"
+
+bool RGBMatrixDelta::checkHeader(const rgbmatrix_delta_header &header) {
+	if ((header.magic != RGBMATRIX_DELTA_MAGIC) || (header.version != RGBMATRIX_DELTA_VERSION))
+		return false;
+	// Encoded for another panel, other settings or another buffering
+	if ((header.layoutSignature != RGBMatrix.getLayoutSignature()) || (header.frameSize != RGBMatrix.getFrameSize()))
+		return false;
+	return header.deltaDistance == (RGBMatrix.isDoubleBuffer() ? 2 : 1);
+}
+
+RGBMatrixDeltaDecoder::RGBMatrixDeltaDecoder() {
+	_words = nullptr;
+	_frameSize = 0;
+	_remaining = 0;
+	_failed = false;
+}
+
+void RGBMatrixDeltaDecoder::begin(uint8_t* buffer, uint32_t frameSize, uint8_t type, uint32_t length, bool raw) {
+	// The buffer may be in IRAM : only 32 bits accesses, a XOR needs no mask to patch one byte of a word
+	_words = (uint32_t*)buffer;
+	_frameSize = frameSize;
+	_remaining = length;
+	_offset = 0;
+	_varint = 0;
+	_shift = 0;
+	_failed = false;
+	if (raw)
+		type |= RGBMATRIX_DELTA_KEYFRAME;
+	if (type & RGBMATRIX_DELTA_KEYFRAME)
+		for (uint32_t i = 0; i < (frameSize + 3) / 4; i++)
+			_words[i] = 0;
+	// A raw frame is a single run over the whole buffer
+	_phase = raw ? DATA : SKIP;
+	_count = raw ? length : 0;
+	if (raw && (length > frameSize))
+		_failed = true;
+}
+
+uint32_t RGBMatrixDeltaDecoder::feed(const uint8_t* data, uint32_t length) {
+	if (length > _remaining)
+		length = _remaining;
+	uint32_t pos = 0;
+	while ((pos < length) && !_failed) {
+		if (_phase != DATA) {
+			uint8_t b = pgm_read_byte(data + pos++);
+			_varint |= (uint32_t)(b & 0x7F) << _shift;
+			_shift += 7;
+			if (b & 0x80)
+				continue;
+			if (_phase == SKIP) {
+				_offset += _varint;
+				_phase = COUNT;
+			}
+			else {
+				_count = _varint;
+				_phase = DATA;
+				if (_offset + _count > _frameSize)
+					_failed = true;
+			}
+			_varint = 0;
+			_shift = 0;
+			continue;
+		}
+
+		uint32_t count = length - pos;
+		if (count > _count)
+			count = _count;
+		_count -= count;
+		for (; count && (_offset & 3); count--, _offset++)
+			_words[_offset >> 2] ^= (uint32_t)pgm_read_byte(data + pos++) << ((_offset & 3) << 3);
+		for (; count >= 4; count -= 4, _offset += 4, pos += 4)
+			_words[_offset >> 2] ^= pgm_read_byte(data + pos) | (pgm_read_byte(data + pos + 1) << 8)
+								| (pgm_read_byte(data + pos + 2) << 16) | ((uint32_t)pgm_read_byte(data + pos + 3) << 24);
+		for (; count; count--, _offset++)
+			_words[_offset >> 2] ^= (uint32_t)pgm_read_byte(data + pos++) << ((_offset & 3) << 3);
+		if (!_count)
+			_phase = SKIP;
+	}
+	_remaining -= pos;
+	// A payload must end on a complete run
+	if (!_remaining && ((_phase != SKIP) || _shift))
+		_failed = true;
+	return pos;
+}
+
+bool RGBMatrixDelta::applyFrame(uint8_t* buffer, uint32_t frameSize, uint8_t type, const uint8_t* payload, uint32_t length) {
+	RGBMatrixDeltaDecoder decoder;
+	decoder.begin(buffer, frameSize, type, length);
+	decoder.feed(payload, length);
+	return decoder.done() && !decoder.failed();
+}
+
+RGBMatrixDeltaPlayer::RGBMatrixDeltaPlayer() {
+	_animation = nullptr;
+	_record = nullptr;
+	memset(&_header, 0, sizeof(_header));
+	_frame = 0;
+	_nextFrame = 0;
+	_shownFrame = 0;
+}
+
+bool RGBMatrixDeltaPlayer::begin(const uint8_t* animation) {
+	_animation = nullptr;
+	memcpy_P(&_header, animation, sizeof(_header));
+	if (!RGBMatrixDelta::checkHeader(_header) || !_header.frameCount)
+		return false;
+	_animation = animation;
+	_record = animation + sizeof(_header);
+	_frame = 0;
+	_nextFrame = millis();
+	_shownFrame = RGBMatrix.getFrameCount() - 1;
+	return true;
+}
+
+bool RGBMatrixDeltaPlayer::update() {
+	if (!_animation || ((int32_t)(millis() - _nextFrame) < 0))
+		return false;
+	// The frame before has not been entirely refreshed yet : swapping now would drop it
+	// (and the delta chain of the edit buffer relies on every frame being shown)
+	if (RGBMatrix.getFrameCount() == _shownFrame)
+		return false;
+
+	uint32_t record = pgm_read_dword(_record);
+	uint32_t length = record >> 8;
+	// A bad record breaks the delta chain : every following frame would be wrong, playback stops
+	if (!RGBMatrixDelta::applyFrame(RGBMatrix.getEditBuffer(), _header.frameSize, record & 0xFF, _record + 4, length)) {
+		_animation = nullptr;
+		return false;
+	}
+	RGBMatrix.showBuffer();
+	_shownFrame = RGBMatrix.getFrameCount();
+
+	// Late by more than a frame : restart the schedule instead of rushing to catch up
+	_nextFrame += _header.frameDelay;
+	if ((int32_t)(millis() - _nextFrame) > _header.frameDelay)
+		_nextFrame = millis() + _header.frameDelay;
+
+	_record += 4 + ((length + 3) & ~3);
+	if (++_frame >= _header.frameCount) {
+		_frame = 0;
+		_record = _animation + sizeof(_header);
+	}
+	return true;
+}
@@ -0,0 +1,80 @@
+#ifndef RGBMatrixDelta_H
+#define RGBMatrixDelta_H
+
+#include "ESP8266RGBMatrix.h"
+
+#define RGBMATRIX_DELTA_MAGIC	0x44424752	// "RGBD"
+#define RGBMATRIX_DELTA_VERSION	1
+
+// Delta compressed animation : this header, then frameCount frame records.
+// A record is a 4 bytes header (type in the low byte, payload length in the upper 24 bits) and a payload
+// of runs : varint skip, varint count, count bytes XORed into the bitplanes. Payloads are padded to 4 bytes.
+// A keyframe clears the buffer before its runs are applied, a delta patches the frame deltaDistance
+// frames back : 2 for double buffering, as the edit buffer then holds the frame before the last one.
+// Generated by extras/tools/rgbmatrix_delta.cpp
+struct rgbmatrix_delta_header {
+	uint32_t magic;				// RGBMATRIX_DELTA_MAGIC
+	uint8_t version;			// RGBMATRIX_DELTA_VERSION
+	uint8_t deltaDistance;		// 1 single buffer, 2 double buffer
+	uint16_t frameCount;
+	uint16_t frameDelay;		// ms between two frames
+	uint16_t reserved;
+	uint32_t frameSize;			// ESP8266RGBMatrix::getFrameSize()
+	uint32_t layoutSignature;	// ESP8266RGBMatrix::getLayoutSignature() of the encoding setup
+	uint32_t dataSize;			// Bytes of frame records after this header
+};
+
+#define RGBMATRIX_DELTA_KEYFRAME	0x01
+#define RGBMATRIX_DELTA_RECORD(type, length)	((uint32_t)(type) | ((uint32_t)(length) << 8))
+
+// Incremental decoder of one record payload : it can be fed in chunks, from a file or a network stream.
+// In raw mode the payload is a whole frame (RGBMatrixAsset frames) copied as one run.
+class RGBMatrixDeltaDecoder {
+public:
+	RGBMatrixDeltaDecoder();
+	void begin(uint8_t* buffer, uint32_t frameSize, uint8_t type, uint32_t length, bool raw = false);
+	uint32_t feed(const uint8_t* data, uint32_t length);	// Returns the bytes consumed (RAM or PROGMEM data)
+	bool done()								{return !_remaining;};
+	bool failed()							{return _failed;};
+
+private:
+	enum decoder_phases { SKIP, COUNT, DATA };
+	uint32_t* _words;
+	uint32_t _frameSize;
+	uint32_t _remaining;					// Payload bytes not fed yet
+	uint32_t _offset;						// Next byte patched in the buffer
+	uint32_t _count;						// Bytes left in the current run
+	uint32_t _varint;
+	uint8_t _shift;
+	decoder_phases _phase;
+	bool _failed;
+};
+
+class RGBMatrixDelta {
+public:
+	// Check a header against the current layout
+	static bool checkHeader(const rgbmatrix_delta_header &header);
+	// Apply one record payload to a frame buffer. The payload may be in RAM or PROGMEM
+	static bool applyFrame(uint8_t* buffer, uint32_t frameSize, uint8_t type, const uint8_t* payload, uint32_t length);
+};
+
+// Plays a delta animation from PROGMEM into the edit buffer
+class RGBMatrixDeltaPlayer {
+public:
+	RGBMatrixDeltaPlayer();
+	bool begin(const uint8_t* animation);	// false if it doesn't match the current layout
+	uint16_t getFrameCount()				{return _header.frameCount;};
+	uint16_t getFrameDelay()				{return _header.frameDelay;};
+	bool update();							// Decode and show the next frame when its time has come
+	bool isPlaying()						{return _animation != nullptr;};	// false after a bad record
+
+private:
+	const uint8_t* _animation;
+	const uint8_t* _record;
+	rgbmatrix_delta_header _header;
+	uint16_t _frame;
+	uint32_t _nextFrame;
+	uint32_t _shownFrame;					// RGBMatrix.getFrameCount() at the last swap
+};
+
+#endif /*RGBMatrixDelta_H*/
@@ -14,9 +14,8 @@ void RGBMatrixDraw::drawPixel(int16_t x, int16_t y, uint16_t color) {
 }
 
 void RGBMatrixDraw::drawPixelRGB565(int16_t x, int16_t y, uint16_t color) {
-	uint8_t r = ((((color >> 11) & 0x1F) * 527) + 23) >> 6;
-	uint8_t g = ((((color >> 5) & 0x3F) * 259) + 33) >> 6;
-	uint8_t b = (((color & 0x1F) * 527) + 23) >> 6;
+	uint8_t r, g, b;
+	rgb565to888(color, r, g, b);
 	RGBMatrix.setPixel(x, y, r, g, b);
 }
 
@@ -0,0 +1,140 @@
+#include "RGBMatrixFire.h"
+
+#define LANES_HIGH	0x80808080
+#define LANES_EVEN	0x00FF00FF
+
+// a - b per byte, 0 when b > a
+static inline uint32_t subSaturate(uint32_t a, uint32_t b) {
+	uint32_t d = ((a | LANES_HIGH) - (b & ~LANES_HIGH)) ^ ((a ^ ~b) & LANES_HIGH);
+	uint32_t borrow = ((~a & b) | (~(a ^ b) & d)) & LANES_HIGH;
+	return d & ~((borrow >> 7) * 0xFF);
+}
+
+// Each byte of r scaled to 0 - (n - 1)
+static inline uint32_t scaleBytes(uint32_t r, uint8_t n) {
+	return (((r & LANES_EVEN) * n >> 8) & LANES_EVEN) | ((((r >> 8) & LANES_EVEN) * n) & ~LANES_EVEN);
+}
+
+// (a + 2 * b) / 3 per byte, in 16 bits lanes : (x * 85 + (x * 21 >> 6) + 4) >> 8 is x / 3 up to 765
+static inline uint32_t third(uint32_t x) {
+	return x * 85 + (((x * 21) >> 6) & 0x03FF03FF) + 0x00040004;
+}
+
+static inline uint32_t diffuse(uint32_t a, uint32_t b) {
+	uint32_t even = (a & LANES_EVEN) + ((b & LANES_EVEN) << 1);
+	uint32_t odd = ((a >> 8) & LANES_EVEN) + (((b >> 8) & LANES_EVEN) << 1);
+	return ((third(even) >> 8) & LANES_EVEN) | (third(odd) & ~LANES_EVEN);
+}
+
+RGBMatrixFire::RGBMatrixFire() {
+	_heat = nullptr;
+	_width = 0;
+	_height = 0;
+	_cooling = 55;
+	_sparking = 120;
+	_random = 2463534242UL;
+}
+
+RGBMatrixFire::~RGBMatrixFire() {
+	end();
+}
+
+void RGBMatrixFire::end() {
+	delete[] _heat;
+	_heat = nullptr;
+}
+
+bool RGBMatrixFire::begin(uint16_t width, uint16_t height) {
+	end();
+	_width = width;
+	_height = height;
+	_words = (width + 3) / 4;
+	if (!width || !height)
+		return false;
+	_heat = new (std::nothrow) uint32_t[_words * height];
+	if (!_heat)
+		return false;
+	memset(_heat, 0, _words * height * 4);
+	return true;
+}
+
+// xorshift32
+uint32_t RGBMatrixFire::random32() {
+	uint32_t x = _random;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return _random = x;
+}
+
+void RGBMatrixFire::step() {
+	if (!_heat)
+		return;
+	// Step 1. Cool down every cell a little
+	uint16_t cool = (_cooling * 10) / _height + 2;
+	uint8_t coolMax = cool > 255 ? 255 : cool;
+	uint32_t* cell = _heat;
+	for (uint32_t i = 0; i < (uint32_t)_words * _height; i++, cell++)
+		if (*cell)
+			*cell = subSaturate(*cell, scaleBytes(random32(), coolMax));
+
+	// Step 2. Heat from each cell drifts up and diffuses a little, the rows below are not updated yet.
+	// As Fire2012 the two bottom rows are only cooled
+	cell = _heat;
+	for (uint32_t i = 0; i + 2 * _words < (uint32_t)_words * _height; i++, cell++)
+		*cell = diffuse(cell[_words], cell[2 * _words]);
+
+	// Step 3. Randomly ignite new sparks of heat in the lowest rows
+	uint8_t sparkRows = _height < RGBMATRIX_FIRE_SPARK_ROWS ? _height : RGBMATRIX_FIRE_SPARK_ROWS;
+	for (uint16_t x = 0; x < _width; x += 4) {
+		uint32_t chance = random32();
+		uint32_t spark = random32();
+		uint32_t row = random32();
+		for (uint8_t b = 0; (b < 4) && (x + b < _width); b++, chance >>= 8, spark >>= 8, row >>= 8) {
+			if ((uint8_t)chance >= _sparking)
+				continue;
+			uint8_t &cell = ((uint8_t*)(_heat + (_height - 1 - ((uint8_t)row * sparkRows >> 8)) * _words))[x + b];
+			uint16_t heat = cell + 160 + (uint8_t)spark * 95 / 256;
+			cell = heat > 255 ? 255 : heat;
+		}
+	}
+}
+
+uint8_t RGBMatrixFire::getHeat(int16_t x, int16_t y) {
+	if (!_heat || (x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+		return 0;
+	return ((uint8_t*)(_heat + y * _words))[x];
+}
+
+void RGBMatrixFire::draw(RGBMatrixIndexed &frame, int16_t x, int16_t y) {
+	uint8_t* indexes = frame.getBuffer();
+	if (!_heat || !indexes)
+		return;
+	int16_t width = frame.getWidth();
+	int16_t height = frame.getHeight();
+	int16_t x0 = x < 0 ? 0 : x;
+	int16_t x1 = x + _width > width ? width : x + _width;
+	if (x1 <= x0)
+		return;
+	for (uint16_t row = 0; row < _height; row++) {
+		int16_t dy = y + row;
+		if ((dy < 0) || (dy >= height))
+			continue;
+		memcpy(indexes + dy * width + x0, (uint8_t*)(_heat + row * _words) + (x0 - x), x1 - x0);
+	}
+	frame.invalidate(x, y, _width, _height);
+}
+
+void RGBMatrixFire::loadHeatPalette(RGBMatrixIndexed &frame) {
+	// As FastLED HeatColor() : thirds ramping up red, then green, then blue
+	for (uint16_t i = 0; i < 256; i++) {
+		uint8_t t = i * 191 / 255;
+		uint8_t ramp = (t & 0x3F) << 2;
+		if (t & 0x80)
+			frame.setColor(i, 255, 255, ramp);
+		else if (t & 0x40)
+			frame.setColor(i, 255, ramp, 0);
+		else
+			frame.setColor(i, ramp, 0, 0);
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef RGBMatrixFire_H
+#define RGBMatrixFire_H
+
+#include "ESP8266RGBMatrix.h"
+#include "RGBMatrixIndexed.h"
+
+// Rows where the sparks are lit, from the bottom one
+#ifndef RGBMATRIX_FIRE_SPARK_ROWS
+#define RGBMATRIX_FIRE_SPARK_ROWS 3
+#endif
+
+// Fire2012 on a whole panel : heat cools down, rises and diffuses, sparks are lit in the lowest rows.
+// The heat bytes are packed 4 per 32 bits word and the cooling, saturating subtraction and diffusion work on
+// whole words (SWAR), with one xorshift random word per 4 cells. The heat is the palette index of a
+// RGBMatrixIndexed frame : draw() copies it, the frame encodes it with the bulk encoder.
+class RGBMatrixFire {
+public:
+	RGBMatrixFire();
+	~RGBMatrixFire();
+	bool begin(uint16_t width, uint16_t height);	// Cold
+	void end();
+	void setCooling(uint8_t cooling)		{_cooling = cooling;};		// Less cooling = taller flames (20 to 100, default 55)
+	void setSparking(uint8_t sparking)		{_sparking = sparking;};	// Chance out of 255 of a new spark per column (50 to 200, default 120)
+	void seed(uint32_t seed)				{_random = seed ? seed : 1;};
+	void step();
+	void draw(RGBMatrixIndexed &frame, int16_t x = 0, int16_t y = 0);	// Heat as indexes, fire bottom left at (x, y + height - 1)
+	static void loadHeatPalette(RGBMatrixIndexed &frame);		// Black, red, yellow, white
+	uint8_t getHeat(int16_t x, int16_t y);
+
+private:
+	uint32_t random32();
+
+	uint16_t _width;
+	uint16_t _height;
+	uint16_t _words;						// Words per row, rows padded to 4 cells
+	uint32_t* _heat;
+	uint8_t _cooling;
+	uint8_t _sparking;
+	uint32_t _random;
+};
+
+#endif /*RGBMatrixFire_H*/
@@ -0,0 +1,176 @@
+#include "RGBMatrixGlyphCache.h"
+
+// Adafruit GFX target recording a glyph in drawBitmap() format, the glyphs are rasterized by Adafruit GFX
+// itself so they match drawChar()
+class GlyphRaster : public Adafruit_GFX {
+public:
+	GlyphRaster() : Adafruit_GFX(1, 1) {
+		_bitmap = nullptr;
+		_width = 0;
+		_height = 0;
+	};
+	void setBitmap(uint8_t* bitmap, int16_t width, int16_t height) {
+		_bitmap = bitmap;
+		_width = width;
+		_height = height;
+	};
+	void drawPixel(int16_t x, int16_t y, uint16_t /*color*/) {
+		if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+			return;
+		_bitmap[y * ((_width + 7) / 8) + x / 8] |= 0x80 >> (x & 7);
+	};
+
+private:
+	uint8_t* _bitmap;
+};
+
+RGBMatrixGlyphCache::RGBMatrixGlyphCache(uint32_t budget, uint8_t count) {
+	_glyphs = new (std::nothrow) glyphEntry[count];
+	_count = _glyphs ? count : 0;
+	_budget = budget;
+	_memory = 0;
+	_tick = 0;
+	_colorDepth = 0;
+	_font = nullptr;
+	_size = 1;
+	for (uint8_t i = 0; i < _count; i++)
+		_glyphs[i].lastUse = 0;
+	resetStats();
+}
+
+RGBMatrixGlyphCache::~RGBMatrixGlyphCache() {
+	delete[] _glyphs;
+}
+
+void RGBMatrixGlyphCache::clear() {
+	for (uint8_t i = 0; i < _count; i++)
+		if (_glyphs[i].lastUse)
+			drop(&_glyphs[i]);
+}
+
+void RGBMatrixGlyphCache::getStats(glyphStats &stats) {
+	stats = _stats;
+	stats.memory = _memory;
+	stats.glyphs = 0;
+	for (uint8_t i = 0; i < _count; i++)
+		if (_glyphs[i].lastUse)
+			stats.glyphs++;
+}
+
+void RGBMatrixGlyphCache::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void RGBMatrixGlyphCache::drop(glyphEntry* glyph) {
+	_memory -= glyph->sprite.getDataSize();
+	glyph->sprite.end();
+	glyph->lastUse = 0;
+}
+
+RGBMatrixGlyphCache::glyphEntry* RGBMatrixGlyphCache::reserve(uint32_t size) {
+	// Drop the least recently used glyphs until there is a free entry and the budget allows size more bytes
+	while (true) {
+		glyphEntry* free = nullptr;
+		glyphEntry* oldest = nullptr;
+		for (uint8_t i = 0; i < _count; i++) {
+			glyphEntry* glyph = &_glyphs[i];
+			if (!glyph->lastUse)
+				free = glyph;
+			else if (!oldest || (glyph->lastUse < oldest->lastUse))
+				oldest = glyph;
+		}
+		if (free && (_memory + size <= _budget))
+			return free;
+		if (!oldest)
+			return nullptr;
+		drop(oldest);
+		_stats.evictions++;
+	}
+}
+
+RGBMatrixGlyphCache::glyphEntry* RGBMatrixGlyphCache::findGlyph(unsigned char c, uint16_t color) {
+	_tick++;
+	for (uint8_t i = 0; i < _count; i++) {
+		glyphEntry* glyph = &_glyphs[i];
+		if (glyph->lastUse && (glyph->c == c) && (glyph->color == color) && (glyph->font == _font) && (glyph->size == _size)) {
+			glyph->lastUse = _tick;
+			_stats.hits++;
+			return glyph;
+		}
+	}
+	_stats.misses++;
+
+	GlyphRaster raster;
+	raster.setFont(_font);
+	raster.setTextSize(_size);
+	raster.setTextWrap(false);
+	char text[2] = {(char)c, 0};
+	int16_t x1, y1;
+	uint16_t w, h;
+	raster.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
+	if (!w || !h)
+		w = h = 0;						// Space : only the advance is kept
+
+	uint32_t size = (uint32_t)((w + 7) / 8 + 1) * (1 + 3 * _colorDepth) * h;
+	// Larger than the whole budget : drawn once from a scratch entry
+	glyphEntry* glyph = size <= _budget ? reserve(size) : &_uncached;
+	if (!glyph)
+		return nullptr;
+
+	uint16_t bitmapSize = (w + 7) / 8 * h;
+	uint8_t* bitmap = nullptr;
+	if (bitmapSize) {
+		bitmap = new (std::nothrow) uint8_t[bitmapSize];
+		if (!bitmap)
+			return nullptr;
+		memset(bitmap, 0, bitmapSize);
+	}
+	raster.setBitmap(bitmap, w, h);
+	raster.setCursor(-x1, -y1);
+	raster.write(c);
+
+	glyph->font = _font;
+	glyph->color = color;
+	glyph->c = c;
+	glyph->size = _size;
+	glyph->offsetX = x1;
+	glyph->offsetY = y1;
+	glyph->advance = raster.getCursorX() + x1;
+	if (glyph != &_uncached)
+		glyph->lastUse = _tick;
+	if (bitmap) {
+		uint8_t r, g, b;
+		rgb565to888(color, r, g, b);
+		glyph->sprite.begin(w, h, bitmap, r, g, b);
+		if (glyph != &_uncached)
+			_memory += glyph->sprite.getDataSize();
+		delete[] bitmap;
+	}
+	return glyph;
+}
+
+int16_t RGBMatrixGlyphCache::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color) {
+	if (_colorDepth != RGBMatrix.getColorDepth()) {
+		clear();
+		_colorDepth = RGBMatrix.getColorDepth();
+	}
+	glyphEntry* glyph = findGlyph(c, color);
+	if (!glyph)
+		return 0;
+	glyph->sprite.draw(x + glyph->offsetX, y + glyph->offsetY);
+	if (glyph == &_uncached)
+		_uncached.sprite.end();
+	return glyph->advance;
+}
+
+int16_t RGBMatrixGlyphCache::drawText(int16_t x, int16_t y, const char* text, uint16_t color) {
+	int16_t cursorX = x;
+	for (; *text; text++) {
+		if (*text == '\n') {
+			cursorX = x;
+			y += _size * (_font ? pgm_read_byte(&_font->yAdvance) : 8);
+		} else if (*text != '\r')
+			cursorX += drawChar(cursorX, y, *text, color);
+	}
+	return cursorX;
+}
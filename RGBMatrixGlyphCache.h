@@ -0,0 +1,69 @@
+#ifndef RGBMatrixGlyphCache_H
+#define RGBMatrixGlyphCache_H
+
+#include "Adafruit_GFX.h"
+#include "RGBMatrixSprite.h"
+
+#ifndef RGBMATRIX_GLYPH_BUDGET
+#define RGBMATRIX_GLYPH_BUDGET 4096			// Bytes of encoded glyphs
+#endif
+#ifndef RGBMATRIX_GLYPH_COUNT
+#define RGBMATRIX_GLYPH_COUNT 48			// Glyphs kept at most
+#endif
+
+// Glyph cache for Adafruit GFX fonts : each font, size, character and color is rasterized once by Adafruit GFX
+// and kept as sprite bit rows, drawing it again is a masked blit 8 pixels at a time instead of a drawPixel()
+// and a RGB565 expansion per glyph pixel. Past the budget the least recently used glyphs are dropped.
+// A built-in font glyph at size 1 and 4 bits of color takes 2 * 13 * 8 = 208 bytes.
+// The glyphs depend on the color settings : clear() after changing them (color depth changes are detected).
+class RGBMatrixGlyphCache {
+public:
+	struct glyphStats {
+		uint32_t hits;
+		uint32_t misses;		// Glyphs rasterized
+		uint32_t evictions;		// Glyphs dropped for the budget
+		uint32_t memory;		// Bytes of the glyphs kept
+		uint8_t glyphs;			// Glyphs kept
+	};
+
+	RGBMatrixGlyphCache(uint32_t budget = RGBMATRIX_GLYPH_BUDGET, uint8_t count = RGBMATRIX_GLYPH_COUNT);
+	~RGBMatrixGlyphCache();
+	void setFont(const GFXfont* font = nullptr)	{_font = font;};	// nullptr : Adafruit GFX built-in 6x8 font
+	void setTextSize(uint8_t size)				{_size = size ? size : 1;};
+	// Same position as Adafruit GFX : top left for the built-in font, baseline for the others
+	int16_t drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color);	// Returns the x advance
+	int16_t drawText(int16_t x, int16_t y, const char* text, uint16_t color);	// Returns x after the text
+	void clear();
+	void getStats(glyphStats &stats);
+	void resetStats();
+
+private:
+	struct glyphEntry {
+		const GFXfont* font;
+		uint16_t color;
+		uint8_t c;
+		uint8_t size;
+		int16_t offsetX;					// Bitmap top left from the cursor
+		int16_t offsetY;
+		int16_t advance;
+		uint32_t lastUse;					// 0 : free entry
+		RGBMatrixSprite sprite;
+	};
+
+	glyphEntry* findGlyph(unsigned char c, uint16_t color);
+	glyphEntry* reserve(uint32_t size);
+	void drop(glyphEntry* glyph);
+
+	glyphEntry* _glyphs;
+	glyphEntry _uncached;
+	uint8_t _count;
+	uint32_t _budget;
+	uint32_t _memory;
+	uint32_t _tick;
+	uint8_t _colorDepth;
+	const GFXfont* _font;
+	uint8_t _size;
+	glyphStats _stats;
+};
+
+#endif /*RGBMatrixGlyphCache_H*/
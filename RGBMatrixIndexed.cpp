@@ -0,0 +1,197 @@
+#include "RGBMatrixIndexed.h"
+
+RGBMatrixIndexed::RGBMatrixIndexed() {
+	_indexes = nullptr;
+	_dirty = nullptr;
+	_lastDirty = nullptr;
+	_width = 0;
+	_height = 0;
+	_paletteOffset = 0;
+}
+
+RGBMatrixIndexed::~RGBMatrixIndexed() {
+	end();
+}
+
+void RGBMatrixIndexed::end() {
+	delete[] _indexes;
+	delete[] _dirty;
+	delete[] _lastDirty;
+	_indexes = nullptr;
+	_dirty = nullptr;
+	_lastDirty = nullptr;
+}
+
+bool RGBMatrixIndexed::begin() {
+	end();
+	_width = RGBMatrix.getWidth();
+	_height = RGBMatrix.getHeight();
+	_groupsPerRow = (_width + 7) / 8;
+	_dirtySize = ((uint32_t)_groupsPerRow * _height + 7) / 8;
+	_indexes = new (std::nothrow) uint8_t[(uint32_t)_width * _height];
+	_dirty = new (std::nothrow) uint8_t[_dirtySize];
+	_lastDirty = new (std::nothrow) uint8_t[_dirtySize];
+	if (!_indexes || !_dirty || !_lastDirty) {
+		end();
+		return false;
+	}
+	memset(_indexes, 0, (uint32_t)_width * _height);
+	memset(_palette, 0, sizeof(_palette));
+	memset(_lastDirty, 0, _dirtySize);
+	_lastFull = false;
+	_paletteOffset = 0;
+	invalidate();
+	return true;
+}
+
+void RGBMatrixIndexed::encodeEntry(uint8_t index) {
+	uint8_t r = _palette[3 * index];
+	uint8_t g = _palette[3 * index + 1];
+	uint8_t b = _palette[3 * index + 2];
+	RGBMatrix.applyColorSettings(r, g, b);
+	uint8_t shift = 8 - RGBMatrix._colorDepth;
+	_encoded[0][index] = r >> shift;
+	_encoded[1][index] = g >> shift;
+	_encoded[2][index] = b >> shift;
+}
+
+void RGBMatrixIndexed::invalidate() {
+	for (uint16_t i = 0; i < 256; i++)
+		encodeEntry(i);
+	memset(_dirtyEntries, 0, sizeof(_dirtyEntries));
+	_paletteDirty = false;
+	_full = true;
+}
+
+void RGBMatrixIndexed::invalidate(int16_t x, int16_t y, int16_t width, int16_t height) {
+	// Only the groups of the area, the palette is still valid
+	if (!_indexes)
+		return;
+	int16_t x0 = x < 0 ? 0 : x;
+	int16_t y0 = y < 0 ? 0 : y;
+	int16_t x1 = x + width > _width ? _width : x + width;
+	int16_t y1 = y + height > _height ? _height : y + height;
+	if ((x0 >= x1) || (y0 >= y1))
+		return;
+	if (!x0 && !y0 && (x1 == _width) && (y1 == _height)) {
+		_full = true;
+		return;
+	}
+	for (int16_t py = y0; py < y1; py++)
+		for (uint16_t g = x0 >> 3; g <= (x1 - 1) >> 3; g++) {
+			uint32_t group = py * _groupsPerRow + g;
+			_dirty[group >> 3] |= 1 << (group & 7);
+		}
+}
+
+void RGBMatrixIndexed::setPixel(int16_t x, int16_t y, uint8_t index) {
+	if (!_indexes || (x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+		return;
+	uint8_t &pixel = _indexes[y * _width + x];
+	if (pixel == index)
+		return;
+	pixel = index;
+	uint32_t group = y * _groupsPerRow + (x >> 3);
+	_dirty[group >> 3] |= 1 << (group & 7);
+}
+
+uint8_t RGBMatrixIndexed::getPixel(int16_t x, int16_t y) {
+	if (!_indexes || (x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+		return 0;
+	return _indexes[y * _width + x];
+}
+
+void RGBMatrixIndexed::fill(uint8_t index) {
+	if (!_indexes)
+		return;
+	memset(_indexes, index, (uint32_t)_width * _height);
+	_full = true;
+}
+
+void RGBMatrixIndexed::setColor(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+	uint8_t* entry = _palette + 3 * index;
+	if ((entry[0] == r) && (entry[1] == g) && (entry[2] == b))
+		return;
+	entry[0] = r;
+	entry[1] = g;
+	entry[2] = b;
+	uint8_t old[3] = {_encoded[0][index], _encoded[1][index], _encoded[2][index]};
+	encodeEntry(index);
+	// Pixels only change if the encoded color does
+	if ((old[0] != _encoded[0][index]) || (old[1] != _encoded[1][index]) || (old[2] != _encoded[2][index])) {
+		_dirtyEntries[index >> 3] |= 1 << (index & 7);
+		_paletteDirty = true;
+	}
+}
+
+void RGBMatrixIndexed::loadPalette(const uint8_t* rgb, uint16_t count, uint8_t first) {
+	for (uint16_t i = 0; (i < count) && (first + i < 256); i++, rgb += 3)
+		setColor(first + i, pgm_read_byte(rgb), pgm_read_byte(rgb + 1), pgm_read_byte(rgb + 2));
+}
+
+void RGBMatrixIndexed::setPaletteOffset(uint8_t offset) {
+	if (offset == _paletteOffset)
+		return;
+	_paletteOffset = offset;
+	_full = true;
+}
+
+uint32_t RGBMatrixIndexed::update() {
+	ESP8266RGBMatrix &matrix = RGBMatrix;
+	if (!_indexes || !matrix._isBegin)
+		return 0;
+	if (!matrix._groupMapValid)
+		matrix.initGroupMap();
+
+	if (_paletteDirty && !_full) {
+		// Groups showing a changed entry
+		uint32_t group = 0;
+		for (uint16_t y = 0; y < _height; y++) {
+			const uint8_t* row = _indexes + y * _width;
+			for (uint16_t x = 0; x < _width; x += 8, group++) {
+				uint8_t n = _width - x < 8 ? _width - x : 8;
+				for (uint8_t i = 0; i < n; i++) {
+					uint8_t entry = row[x + i] + _paletteOffset;
+					if (_dirtyEntries[entry >> 3] & (1 << (entry & 7))) {
+						_dirty[group >> 3] |= 1 << (group & 7);
+						break;
+					}
+				}
+			}
+		}
+	}
+	memset(_dirtyEntries, 0, sizeof(_dirtyEntries));
+	_paletteDirty = false;
+
+	bool full = _full || (matrix._doubleBuffer && _lastFull);
+	bool doubleBuffer = matrix._doubleBuffer && !full;
+	uint8_t r[8] = {0}, g[8] = {0}, b[8] = {0};
+	uint32_t pixels = 0;
+	uint32_t group = 0;
+	for (uint16_t y = 0; y < _height; y++) {
+		const uint8_t* row = _indexes + y * _width;
+		for (uint16_t x = 0; x < _width; x += 8, group++) {
+			uint8_t bit = 1 << (group & 7);
+			if (!full && !(_dirty[group >> 3] & bit) && !(doubleBuffer && (_lastDirty[group >> 3] & bit)))
+				continue;
+			uint8_t n = _width - x < 8 ? _width - x : 8;
+			for (uint8_t i = 0; i < n; i++) {
+				uint8_t entry = row[x + i] + _paletteOffset;
+				r[i] = _encoded[0][entry];
+				g[i] = _encoded[1][entry];
+				b[i] = _encoded[2][entry];
+			}
+			matrix.encodeGroup(matrix._edit_buffer, x, y, r, g, b, (1 << n) - 1);
+			pixels += n;
+		}
+	}
+
+	// Kept for the other buffer
+	uint8_t* last = _lastDirty;
+	_lastDirty = _dirty;
+	_dirty = last;
+	memset(_dirty, 0, _dirtySize);
+	_lastFull = _full;
+	_full = false;
+	return pixels;
+}
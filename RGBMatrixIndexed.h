@@ -0,0 +1,50 @@
+#ifndef RGBMatrixIndexed_H
+#define RGBMatrixIndexed_H
+
+#include "ESP8266RGBMatrix.h"
+
+// Palette indexed frame : one byte per pixel (a third of a RGB shadow buffer) and a 256 colors palette kept
+// already processed by the color settings and shifted to the color depth, so update() encodes 8 indexes at a time
+// with the bulk encoder. Changing palette entries encodes again only the pixels using them, and palette cycling
+// with setPaletteOffset() is one pass over the frame without touching the indexes.
+// With double buffering the pixels of the previous update are encoded too, the edit buffer holds the frame before.
+class RGBMatrixIndexed {
+public:
+	RGBMatrixIndexed();
+	~RGBMatrixIndexed();
+	bool begin();							// After RGBMatrix.begin() : index 0 everywhere, black palette
+	void end();
+	void setPixel(int16_t x, int16_t y, uint8_t index);
+	uint8_t getPixel(int16_t x, int16_t y);
+	void fill(uint8_t index);
+	uint8_t* getBuffer()					{return _indexes;};		// Row major indexes, invalidate the area written to
+	uint16_t getWidth()						{return _width;};
+	uint16_t getHeight()					{return _height;};
+	void setColor(uint8_t index, uint8_t r, uint8_t g, uint8_t b);
+	void loadPalette(const uint8_t* rgb, uint16_t count = 256, uint8_t first = 0);	// RGB888 entries, RAM or PROGMEM
+	void setPaletteOffset(uint8_t offset);	// Index i is shown with the entry i + offset
+	uint8_t getPaletteOffset()				{return _paletteOffset;};
+	void invalidate();						// Everything encoded again, also after changing the color settings
+	void invalidate(int16_t x, int16_t y, int16_t width, int16_t height);	// Pixels written through getBuffer()
+	uint32_t update();						// Encode the changes into the edit buffer, returns the pixels encoded
+
+private:
+	void encodeEntry(uint8_t index);
+
+	uint16_t _width;
+	uint16_t _height;
+	uint16_t _groupsPerRow;
+	uint8_t* _indexes;
+	uint8_t* _dirty;						// 1 bit per 8 pixels group
+	uint8_t* _lastDirty;					// Groups of the last update, for double buffering
+	uint32_t _dirtySize;
+	bool _full;								// Whole frame to encode
+	bool _lastFull;
+	uint8_t _palette[256 * 3];				// RGB888
+	uint8_t _encoded[3][256];				// Color settings applied, shifted to the color depth
+	uint8_t _dirtyEntries[256 / 8];
+	bool _paletteDirty;
+	uint8_t _paletteOffset;
+};
+
+#endif /*RGBMatrixIndexed_H*/
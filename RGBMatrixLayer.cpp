@@ -0,0 +1,356 @@
+#include "RGBMatrixLayer.h"
+
+// Smallest rectangle holding both
+static void mergeRect(rgbmatrix_rect &rect, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+	if (x0 < rect.x0)	rect.x0 = x0;
+	if (y0 < rect.y0)	rect.y0 = y0;
+	if (x1 > rect.x1)	rect.x1 = x1;
+	if (y1 > rect.y1)	rect.y1 = y1;
+}
+
+RGBMatrixLayer::RGBMatrixLayer(layer_formats format, int16_t width, int16_t height) : Adafruit_GFX(width, height) {
+	_format = format;
+	_pixels = nullptr;
+	_x = 0;
+	_y = 0;
+	_z = 0;
+	_visible = true;
+	_hasTransparent = false;
+	_transparent = 0;
+	_palette = nullptr;
+	_color[0] = _color[1] = _color[2] = 255;
+	_dirty.x0 = _dirty.x1 = 0;
+	_compositor = nullptr;
+}
+
+RGBMatrixLayer::~RGBMatrixLayer() {
+	if (_compositor)
+		_compositor->remove(*this);
+	end();
+}
+
+bool RGBMatrixLayer::begin() {
+	end();
+	uint32_t size;
+	if (_format == LAYER_MASK)
+		size = (WIDTH + 7) / 8 * HEIGHT;
+	else
+		size = (_format == LAYER_RGB565 ? 2 : 1) * WIDTH * HEIGHT;
+	_pixels = new (std::nothrow) uint8_t[size];
+	if (!_pixels)
+		return false;
+	memset(_pixels, 0, size);
+	invalidate();
+	return true;
+}
+
+void RGBMatrixLayer::end() {
+	if (_pixels)
+		invalidateArea();
+	delete[] _pixels;
+	_pixels = nullptr;
+}
+
+void RGBMatrixLayer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+	if (!_pixels || (x < 0) || (x >= WIDTH) || (y < 0) || (y >= HEIGHT))
+		return;
+	switch (_format) {
+		case LAYER_RGB565:
+			((uint16_t*)_pixels)[y * WIDTH + x] = color;
+			break;
+		case LAYER_INDEXED:
+			_pixels[y * WIDTH + x] = color;
+			break;
+		case LAYER_MASK:
+			if (color)
+				_pixels[y * ((WIDTH + 7) / 8) + x / 8] |= 0x80 >> (x & 7);
+			else
+				_pixels[y * ((WIDTH + 7) / 8) + x / 8] &= ~(0x80 >> (x & 7));
+			break;
+	}
+	if (_dirty.x0 >= _dirty.x1) {
+		_dirty.x0 = x;
+		_dirty.y0 = y;
+		_dirty.x1 = x + 1;
+		_dirty.y1 = y + 1;
+	} else
+		mergeRect(_dirty, x, y, x + 1, y + 1);
+}
+
+void RGBMatrixLayer::fillScreen(uint16_t color) {
+	if (!_pixels)
+		return;
+	switch (_format) {
+		case LAYER_RGB565:
+			for (uint32_t i = 0; i < (uint32_t)WIDTH * HEIGHT; i++)
+				((uint16_t*)_pixels)[i] = color;
+			break;
+		case LAYER_INDEXED:
+			memset(_pixels, color, WIDTH * HEIGHT);
+			break;
+		case LAYER_MASK:
+			memset(_pixels, color ? 0xFF : 0x00, (WIDTH + 7) / 8 * HEIGHT);
+			break;
+	}
+	invalidate();
+}
+
+void RGBMatrixLayer::invalidate() {
+	_dirty.x0 = 0;
+	_dirty.y0 = 0;
+	_dirty.x1 = WIDTH;
+	_dirty.y1 = HEIGHT;
+}
+
+void RGBMatrixLayer::invalidateArea() {
+	if (_compositor && _visible)
+		_compositor->addRect(_x, _y, _x + WIDTH, _y + HEIGHT);
+}
+
+void RGBMatrixLayer::setPosition(int16_t x, int16_t y) {
+	if ((x == _x) && (y == _y))
+		return;
+	invalidateArea();
+	_x = x;
+	_y = y;
+	invalidateArea();
+}
+
+void RGBMatrixLayer::setVisible(bool visible) {
+	if (visible == _visible)
+		return;
+	invalidateArea();
+	_visible = visible;
+	invalidateArea();
+}
+
+void RGBMatrixLayer::setZ(int8_t z) {
+	if (z == _z)
+		return;
+	_z = z;
+	invalidateArea();
+}
+
+void RGBMatrixLayer::setTransparent(uint16_t color, bool enable) {
+	_transparent = color;
+	_hasTransparent = enable;
+	invalidate();
+}
+
+void RGBMatrixLayer::setPalette(const uint8_t* rgb) {
+	_palette = rgb;
+	invalidate();
+}
+
+void RGBMatrixLayer::setColor(uint8_t r, uint8_t g, uint8_t b) {
+	_color[0] = r;
+	_color[1] = g;
+	_color[2] = b;
+	invalidate();
+}
+
+void RGBMatrixLayer::composeRow(int16_t y, int16_t x0, int16_t x1, uint8_t* rgb) {
+	// Writes the opaque pixels x0 to x1 - 1 of the row, rgb is the x0 one
+	switch (_format) {
+		case LAYER_RGB565: {
+			const uint16_t* pixels = (const uint16_t*)_pixels + y * WIDTH;
+			for (int16_t x = x0; x < x1; x++, rgb += 3) {
+				uint16_t color = pixels[x];
+				if (_hasTransparent && (color == _transparent))
+					continue;
+				rgb565to888(color, rgb[0], rgb[1], rgb[2]);
+			}
+			break;
+		}
+		case LAYER_INDEXED: {
+			if (!_palette)
+				return;
+			const uint8_t* pixels = _pixels + y * WIDTH;
+			for (int16_t x = x0; x < x1; x++, rgb += 3) {
+				uint8_t index = pixels[x];
+				if (_hasTransparent && (index == _transparent))
+					continue;
+				rgb[0] = pgm_read_byte(_palette + 3 * index);
+				rgb[1] = pgm_read_byte(_palette + 3 * index + 1);
+				rgb[2] = pgm_read_byte(_palette + 3 * index + 2);
+			}
+			break;
+		}
+		case LAYER_MASK: {
+			const uint8_t* pixels = _pixels + y * ((WIDTH + 7) / 8);
+			for (int16_t x = x0; x < x1; x++, rgb += 3)
+				if (pixels[x / 8] & (0x80 >> (x & 7))) {
+					rgb[0] = _color[0];
+					rgb[1] = _color[1];
+					rgb[2] = _color[2];
+				}
+			break;
+		}
+	}
+}
+
+RGBMatrixCompositor::RGBMatrixCompositor() {
+	_layerCount = 0;
+	_rectCount = 0;
+	_lastRectCount = 0;
+	_row = nullptr;
+	_rowWidth = 0;
+	_background[0] = _background[1] = _background[2] = 0;
+	invalidate();
+}
+
+RGBMatrixCompositor::~RGBMatrixCompositor() {
+	while (_layerCount)
+		remove(*_layers[0]);
+	delete[] _row;
+}
+
+bool RGBMatrixCompositor::add(RGBMatrixLayer &layer) {
+	if (layer._compositor || (_layerCount >= RGBMATRIX_LAYERS))
+		return false;
+	_layers[_layerCount++] = &layer;
+	layer._compositor = this;
+	layer.invalidateArea();
+	return true;
+}
+
+void RGBMatrixCompositor::remove(RGBMatrixLayer &layer) {
+	for (uint8_t i = 0; i < _layerCount; i++)
+		if (_layers[i] == &layer) {
+			layer.invalidateArea();
+			layer._compositor = nullptr;
+			_layerCount--;
+			for (; i < _layerCount; i++)
+				_layers[i] = _layers[i + 1];
+			return;
+		}
+}
+
+void RGBMatrixCompositor::setBackground(uint8_t r, uint8_t g, uint8_t b) {
+	_background[0] = r;
+	_background[1] = g;
+	_background[2] = b;
+	invalidate();
+}
+
+void RGBMatrixCompositor::invalidate() {
+	// The panel size may not be known yet, addRect() clips at update time
+	_rects[0].x0 = 0;
+	_rects[0].y0 = 0;
+	_rects[0].x1 = INT16_MAX;
+	_rects[0].y1 = INT16_MAX;
+	_rectCount = 1;
+}
+
+void RGBMatrixCompositor::invalidate(int16_t x, int16_t y, int16_t width, int16_t height) {
+	addRect(x, y, x + width, y + height);
+}
+
+void RGBMatrixCompositor::addRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+	if ((x0 >= x1) || (y0 >= y1))
+		return;
+	// Overlapping or touching regions are merged, when the list is full into the one growing the least
+	uint8_t best = 0;
+	int32_t bestGrowth = INT32_MAX;
+	for (uint8_t i = 0; i < _rectCount; i++) {
+		rgbmatrix_rect &rect = _rects[i];
+		if ((x0 <= rect.x1) && (x1 >= rect.x0) && (y0 <= rect.y1) && (y1 >= rect.y0)) {
+			best = i;
+			bestGrowth = -1;
+			break;
+		}
+		rgbmatrix_rect merged = rect;
+		mergeRect(merged, x0, y0, x1, y1);
+		int32_t growth = (int32_t)(merged.x1 - merged.x0) * (merged.y1 - merged.y0) - (int32_t)(rect.x1 - rect.x0) * (rect.y1 - rect.y0);
+		if (growth < bestGrowth) {
+			best = i;
+			bestGrowth = growth;
+		}
+	}
+	if ((bestGrowth >= 0) && (_rectCount < RGBMATRIX_DIRTY_RECTS)) {
+		rgbmatrix_rect &rect = _rects[_rectCount++];
+		rect.x0 = x0;
+		rect.y0 = y0;
+		rect.x1 = x1;
+		rect.y1 = y1;
+		return;
+	}
+	mergeRect(_rects[best], x0, y0, x1, y1);
+}
+
+void RGBMatrixCompositor::composeRect(const rgbmatrix_rect &rect) {
+	for (int16_t y = rect.y0; y < rect.y1; y++) {
+		uint8_t* rgb = _row;
+		for (int16_t x = rect.x0; x < rect.x1; x++, rgb += 3) {
+			rgb[0] = _background[0];
+			rgb[1] = _background[1];
+			rgb[2] = _background[2];
+		}
+		for (uint8_t i = 0; i < _layerCount; i++) {
+			RGBMatrixLayer* layer = _layers[i];
+			int16_t ly = y - layer->_y;
+			if (!layer->_visible || !layer->_pixels || (ly < 0) || (ly >= layer->HEIGHT))
+				continue;
+			int16_t x0 = rect.x0 > layer->_x ? rect.x0 : layer->_x;
+			int16_t x1 = layer->_x + layer->WIDTH;
+			if (x1 > rect.x1)
+				x1 = rect.x1;
+			if (x0 < x1)
+				layer->composeRow(ly, x0 - layer->_x, x1 - layer->_x, _row + 3 * (x0 - rect.x0));
+		}
+		RGBMatrix.writeRGB888(rect.x0, y, _row, rect.x1 - rect.x0);
+	}
+}
+
+uint32_t RGBMatrixCompositor::update() {
+	uint16_t width = RGBMatrix.getWidth();
+	uint16_t height = RGBMatrix.getHeight();
+	if (_rowWidth != width) {
+		delete[] _row;
+		_row = new (std::nothrow) uint8_t[3 * width];
+		_rowWidth = _row ? width : 0;
+		if (!_row)
+			return 0;
+	}
+
+	// Layers sorted by z, the last added first on equal z
+	for (uint8_t i = 1; i < _layerCount; i++) {
+		RGBMatrixLayer* layer = _layers[i];
+		uint8_t j = i;
+		for (; j && (_layers[j - 1]->_z > layer->_z); j--)
+			_layers[j] = _layers[j - 1];
+		_layers[j] = layer;
+	}
+	for (uint8_t i = 0; i < _layerCount; i++) {
+		RGBMatrixLayer* layer = _layers[i];
+		rgbmatrix_rect &dirty = layer->_dirty;
+		if ((dirty.x0 < dirty.x1) && layer->_visible)
+			addRect(layer->_x + dirty.x0, layer->_y + dirty.y0, layer->_x + dirty.x1, layer->_y + dirty.y1);
+		dirty.x0 = dirty.x1 = 0;
+	}
+
+	// Regions of this update, then the last ones missing from the other buffer
+	rgbmatrix_rect rects[RGBMATRIX_DIRTY_RECTS];
+	uint8_t rectCount = _rectCount;
+	memcpy(rects, _rects, sizeof(rects));
+	if (RGBMatrix.isDoubleBuffer())
+		for (uint8_t i = 0; i < _lastRectCount; i++)
+			addRect(_lastRects[i].x0, _lastRects[i].y0, _lastRects[i].x1, _lastRects[i].y1);
+	memcpy(_lastRects, rects, sizeof(rects));
+	_lastRectCount = rectCount;
+
+	uint32_t pixels = 0;
+	for (uint8_t i = 0; i < _rectCount; i++) {
+		rgbmatrix_rect rect = _rects[i];
+		if (rect.x0 < 0)		rect.x0 = 0;
+		if (rect.y0 < 0)		rect.y0 = 0;
+		if (rect.x1 > width)	rect.x1 = width;
+		if (rect.y1 > height)	rect.y1 = height;
+		if ((rect.x0 >= rect.x1) || (rect.y0 >= rect.y1))
+			continue;
+		composeRect(rect);
+		pixels += (uint32_t)(rect.x1 - rect.x0) * (rect.y1 - rect.y0);
+	}
+	_rectCount = 0;
+	return pixels;
+}
@@ -0,0 +1,100 @@
+#ifndef RGBMatrixLayer_H
+#define RGBMatrixLayer_H
+
+#include "Adafruit_GFX.h"
+#include "ESP8266RGBMatrix.h"
+
+#ifndef RGBMATRIX_LAYERS
+#define RGBMATRIX_LAYERS 8					// Layers of a compositor
+#endif
+#ifndef RGBMATRIX_DIRTY_RECTS
+#define RGBMATRIX_DIRTY_RECTS 8				// Regions encoded by one update, more are merged
+#endif
+
+enum layer_formats {LAYER_RGB565, LAYER_INDEXED, LAYER_MASK};
+
+struct rgbmatrix_rect {
+	int16_t x0;
+	int16_t y0;
+	int16_t x1;								// Excluded
+	int16_t y1;								// Excluded
+};
+
+class RGBMatrixCompositor;
+
+// Compositor layer drawn with Adafruit GFX in layer coordinates, the color given to drawPixel() depends on the format :
+//  LAYER_RGB565 : RGB565 color, 2 bytes per pixel
+//  LAYER_INDEXED : palette index, 1 byte per pixel
+//  LAYER_MASK : 0 transparent, else the layer color, 1 bit per pixel
+// The layer only records the area changed since the last update of its compositor.
+class RGBMatrixLayer : public Adafruit_GFX {
+public:
+	RGBMatrixLayer(layer_formats format, int16_t width, int16_t height);
+	~RGBMatrixLayer();
+	bool begin();							// Filled with 0
+	void end();
+	void drawPixel(int16_t x, int16_t y, uint16_t color);
+	void fillScreen(uint16_t color);
+	void setPosition(int16_t x, int16_t y);	// Panel position of the layer top left pixel
+	void setVisible(bool visible);
+	void setZ(int8_t z);					// Higher layers are drawn over the lower ones
+	void setTransparent(uint16_t color, bool enable = true);	// RGB565 color or palette index not drawn
+	void setPalette(const uint8_t* rgb);	// LAYER_INDEXED : RGB888 entries in RAM or PROGMEM, not copied
+	void setColor(uint8_t r, uint8_t g, uint8_t b);	// LAYER_MASK
+	void invalidate();						// The whole layer is encoded again by the next update
+	int16_t getX()							{return _x;};
+	int16_t getY()							{return _y;};
+	int8_t getZ()							{return _z;};
+	bool isVisible()						{return _visible;};
+
+private:
+	friend class RGBMatrixCompositor;
+	void composeRow(int16_t y, int16_t x0, int16_t x1, uint8_t* rgb);
+	void invalidateArea();					// Layer area in the compositor
+
+	layer_formats _format;
+	uint8_t* _pixels;
+	int16_t _x;
+	int16_t _y;
+	int8_t _z;
+	bool _visible;
+	bool _hasTransparent;
+	uint16_t _transparent;
+	const uint8_t* _palette;
+	uint8_t _color[3];
+	rgbmatrix_rect _dirty;					// Layer coordinates, empty if x0 >= x1
+	RGBMatrixCompositor* _compositor;
+};
+
+// Merges layers into the edit buffer : only the regions where a layer changed, moved or was hidden are composed
+// again, bottom layer first, and encoded a row at a time with writeRGB888(). Static layers cost nothing per frame.
+// With double buffering the regions of the previous update are encoded too, the edit buffer holds the frame before.
+// Anything else drawn into the edit buffer is kept until a layer over it changes.
+class RGBMatrixCompositor {
+public:
+	RGBMatrixCompositor();
+	~RGBMatrixCompositor();
+	bool add(RGBMatrixLayer &layer);		// At most RGBMATRIX_LAYERS
+	void remove(RGBMatrixLayer &layer);
+	void setBackground(uint8_t r, uint8_t g, uint8_t b);	// Where no layer is drawn, black by default
+	void invalidate();						// The whole panel is encoded by the next update
+	void invalidate(int16_t x, int16_t y, int16_t width, int16_t height);
+	uint32_t update();						// Encode the changes into the edit buffer, returns the pixels encoded
+
+private:
+	friend class RGBMatrixLayer;
+	void addRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+	void composeRect(const rgbmatrix_rect &rect);
+
+	RGBMatrixLayer* _layers[RGBMATRIX_LAYERS];
+	uint8_t _layerCount;
+	rgbmatrix_rect _rects[RGBMATRIX_DIRTY_RECTS];
+	uint8_t _rectCount;
+	rgbmatrix_rect _lastRects[RGBMATRIX_DIRTY_RECTS];	// Regions of the last update, for double buffering
+	uint8_t _lastRectCount;
+	uint8_t* _row;
+	uint16_t _rowWidth;
+	uint8_t _background[3];
+};
+
+#endif /*RGBMatrixLayer_H*/
@@ -0,0 +1,168 @@
+#include "RGBMatrixLife.h"
+
+RGBMatrixLife::RGBMatrixLife() {
+	_cells = nullptr;
+	_next = nullptr;
+	_width = 0;
+	_height = 0;
+	_generation = 0;
+}
+
+RGBMatrixLife::~RGBMatrixLife() {
+	end();
+}
+
+void RGBMatrixLife::end() {
+	delete[] _cells;
+	delete[] _next;
+	_cells = nullptr;
+	_next = nullptr;
+}
+
+bool RGBMatrixLife::begin(uint16_t width, uint16_t height) {
+	end();
+	_width = width;
+	_height = height;
+	_words = (width + 31) / 32;
+	_lastMask = (width & 31) ? (1UL << (width & 31)) - 1 : 0xFFFFFFFF;
+	if (!width || !height)
+		return false;
+	_cells = new (std::nothrow) uint32_t[_words * height];
+	_next = new (std::nothrow) uint32_t[_words * height];
+	if (!_cells || !_next) {
+		end();
+		return false;
+	}
+	clear();
+	return true;
+}
+
+void RGBMatrixLife::clear() {
+	if (_cells)
+		memset(_cells, 0, _words * _height * 4);
+	_generation = 0;
+}
+
+void RGBMatrixLife::randomize(uint8_t density) {
+	if (!_cells)
+		return;
+	for (uint32_t i = 0; i < (uint32_t)_words * _height; i++) {
+		uint32_t word = 0;
+		for (uint8_t b = 0; b < 32; b++)
+			if ((uint8_t)random(256) < density)
+				word |= 1UL << b;
+		_cells[i] = ((i % _words) == _words - 1u) ? word & _lastMask : word;
+	}
+	_generation = 0;
+}
+
+void RGBMatrixLife::setCell(int16_t x, int16_t y, bool alive) {
+	if (!_cells || (x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+		return;
+	uint32_t &word = _cells[y * _words + (x >> 5)];
+	if (alive)
+		word |= 1UL << (x & 31);
+	else
+		word &= ~(1UL << (x & 31));
+}
+
+bool RGBMatrixLife::getCell(int16_t x, int16_t y) {
+	if (!_cells || (x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+		return false;
+	return (_cells[y * _words + (x >> 5)] >> (x & 31)) & 1;
+}
+
+uint32_t RGBMatrixLife::step() {
+	if (!_cells)
+		return 0;
+	uint32_t population = 0;
+	uint32_t lastBit = 1UL << ((_width - 1) & 31);
+	for (uint16_t y = 0; y < _height; y++) {
+		const uint32_t* rows[3] = {
+			_cells + (y ? y - 1 : _height - 1) * _words,
+			_cells + y * _words,
+			_cells + (y + 1 < _height ? y + 1 : 0) * _words};
+		uint32_t* out = _next + y * _words;
+		for (uint16_t w = 0; w < _words; w++) {
+			// Left and right neighbours of the 32 cells of each row, wrapping around the row
+			uint32_t s0[3], s1[3];
+			for (uint8_t r = 0; r < 3; r++) {
+				const uint32_t* row = rows[r];
+				uint32_t c = row[w];
+				uint32_t left = (c << 1) | (w ? row[w - 1] >> 31 : ((row[_words - 1] & lastBit) ? 1 : 0));
+				uint32_t right = (c >> 1) | (w + 1 < _words ? row[w + 1] << 31 : 0);
+				if (w == _words - 1)
+					right = (right & ~lastBit) | ((row[0] & 1) ? lastBit : 0);
+				// Sum of left + right, plus the cell itself for the rows above and below
+				uint32_t p0 = left ^ right;
+				uint32_t p1 = left & right;
+				if (r == 1) {
+					s0[r] = p0;
+					s1[r] = p1;
+				} else {
+					s0[r] = p0 ^ c;
+					s1[r] = p1 | (p0 & c);
+				}
+			}
+			// Total = s0 bits + 2 * (s1 bits + carry), alive next if it is 3, or 2 for a live cell
+			uint32_t x01 = s0[0] ^ s0[1];
+			uint32_t sum0 = x01 ^ s0[2];
+			uint32_t carry0 = (s0[0] & s0[1]) | (s0[2] & x01);
+			uint32_t a = s1[0] ^ s1[1];
+			uint32_t b = s1[2] ^ carry0;
+			uint32_t twos = (a ^ b) & ~((s1[0] & s1[1]) | (s1[2] & carry0) | (a & b));	// Exactly one of the 4
+			uint32_t next = twos & (sum0 | rows[1][w]);
+			if (w == _words - 1)
+				next &= _lastMask;
+			out[w] = next;
+			population += __builtin_popcount(next);
+		}
+	}
+	uint32_t* cells = _cells;
+	_cells = _next;
+	_next = cells;
+	_generation++;
+	return population;
+}
+
+void RGBMatrixLife::draw(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) {
+	ESP8266RGBMatrix &matrix = RGBMatrix;
+	if (!_cells || !matrix._isBegin)
+		return;
+	if (!matrix._groupMapValid)
+		matrix.initGroupMap();
+	matrix.applyColorSettings(r, g, b);
+	uint8_t values[3] = {(uint8_t)(r >> (8 - matrix._colorDepth)), (uint8_t)(g >> (8 - matrix._colorDepth)), (uint8_t)(b >> (8 - matrix._colorDepth))};
+
+	// One color : a plane of the group is all the live cells or nothing
+	uint8_t planeBits[3 * 8];
+	int16_t x0 = x < 0 ? 0 : x;
+	int16_t x1 = x + _width > matrix._width ? matrix._width : x + _width;
+	for (uint16_t cy = 0; cy < _height; cy++) {
+		int16_t dy = y + cy;
+		if ((dy < 0) || (dy >= matrix._height))
+			continue;
+		const uint8_t* row = (const uint8_t*)(_cells + cy * _words);
+		for (int16_t gx = x0 & ~7; gx < x1; gx += 8) {
+			// Cells of the group from cell s, the row bytes are cells 8 at a time (little endian words)
+			int16_t s = gx - x;
+			uint8_t cells;
+			if (s < 0)
+				cells = row[0] << -s;
+			else if (s + 8 < 32 * _words)
+				cells = (row[s >> 3] | (row[(s >> 3) + 1] << 8)) >> (s & 7);
+			else
+				cells = row[s >> 3] >> (s & 7);
+			if (gx + 8 > x1)
+				cells &= 0xFF >> (gx + 8 - x1);
+			if (gx < x0)
+				cells &= 0xFF << (x0 - gx);
+			if (!cells)
+				continue;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < matrix._colorDepth; p++)
+					planeBits[8 * c + p] = ((values[c] >> p) & 0x01) ? cells : 0;
+			matrix.writeGroup(matrix._edit_buffer, gx, dy, planeBits, cells);
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#ifndef RGBMatrixLife_H
+#define RGBMatrixLife_H
+
+#include "ESP8266RGBMatrix.h"
+
+// Game of Life on a bit packed grid wrapping around its edges : 32 cells per word (cell x in bit x & 31), the
+// neighbours are counted with full adders on whole words so a generation is a few dozen operations per 32 cells.
+// draw() expands the live cells with one color into the bitplanes 8 at a time, dead cells are left untouched :
+// RGBMatrix.dim() before it gives fading trails.
+class RGBMatrixLife {
+public:
+	RGBMatrixLife();
+	~RGBMatrixLife();
+	bool begin(uint16_t width, uint16_t height);	// Every cell dead
+	void end();
+	void clear();
+	void randomize(uint8_t density);		// Live cells per 256
+	void setCell(int16_t x, int16_t y, bool alive);
+	bool getCell(int16_t x, int16_t y);
+	uint32_t step();						// Next generation, returns the live cells
+	void draw(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);	// Live cells into the edit buffer, grid top left at (x, y)
+	uint32_t getGeneration()				{return _generation;};
+	uint16_t getWidth()						{return _width;};
+	uint16_t getHeight()					{return _height;};
+
+private:
+	uint16_t _width;
+	uint16_t _height;
+	uint16_t _words;						// Words per row
+	uint32_t _lastMask;						// Cells of the last word of a row
+	uint32_t* _cells;
+	uint32_t* _next;
+	uint32_t _generation;
+};
+
+#endif /*RGBMatrixLife_H*/
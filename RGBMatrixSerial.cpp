@@ -0,0 +1,265 @@
+#include "RGBMatrixSerial.h"
+
+// Pixels converted at once for RGB565 and palette rectangles
+#define RGBMATRIX_SERIAL_CHUNK 64
+
+RGBMatrixSerial::RGBMatrixSerial() {
+	_stream = nullptr;
+	_payload = nullptr;
+	_palette = nullptr;
+	resetStats();
+}
+
+RGBMatrixSerial::~RGBMatrixSerial() {
+	end();
+}
+
+bool RGBMatrixSerial::begin(Stream &stream) {
+	if (!_payload)
+		_payload = new (std::nothrow) uint32_t[(RGBMATRIX_SERIAL_PAYLOAD + RGBMATRIX_SERIAL_CRC + 3) / 4];
+	if (!_payload)
+		return false;
+	_stream = &stream;
+	_state = SYNC;
+	_expected = 0;
+	_nakSent = false;
+	_swapPending = false;
+	_shownFrame = RGBMatrix.getFrameCount() - 1;
+	return true;
+}
+
+void RGBMatrixSerial::end() {
+	delete[] _payload;
+	delete[] _palette;
+	_payload = nullptr;
+	_palette = nullptr;
+	_stream = nullptr;
+}
+
+bool RGBMatrixSerial::update() {
+	if (!_stream)
+		return false;
+
+	// The edit buffer becomes the shown one : nothing is written before the swap
+	if (_swapPending) {
+		if (RGBMatrix.getFrameCount() == _shownFrame)
+			return false;
+		RGBMatrix.showBuffer();
+		if (_swapFlags & RGBMATRIX_SERIAL_SHOW_COPY)
+			RGBMatrix.copyBuffer(false);
+		_shownFrame = RGBMatrix.getFrameCount();
+		_swapPending = false;
+		_stats.frames++;
+		reply(RGBMATRIX_SERIAL_ACK, _swapSequence);
+		return true;
+	}
+
+	int available;
+	while (!_swapPending && ((available = _stream->available()) > 0)) {
+		switch (_state) {
+			case SYNC:
+				if (_stream->read() == RGBMATRIX_SERIAL_SYNC) {
+					_header[0] = RGBMATRIX_SERIAL_SYNC;
+					_received = 1;
+					_state = HEADER;
+				}
+				break;
+			case HEADER: {
+				uint16_t n = RGBMATRIX_SERIAL_HEADER - _received;
+				if (n > available)
+					n = available;
+				_received += _stream->readBytes(_header + _received, n);
+				if (_received < RGBMATRIX_SERIAL_HEADER)
+					break;
+				_length = _header[3] | (_header[4] << 8);
+				if (_length > RGBMATRIX_SERIAL_PAYLOAD) {
+					// Not a header : look for the next sync
+					_stats.invalid++;
+					_state = SYNC;
+					break;
+				}
+				_received = 0;
+				_state = PAYLOAD;
+				break;
+			}
+			case PAYLOAD: {
+				uint16_t n = _length + RGBMATRIX_SERIAL_CRC - _received;
+				if (n > available)
+					n = available;
+				_received += _stream->readBytes((uint8_t*)_payload + _received, n);
+				if (_received < _length + RGBMATRIX_SERIAL_CRC)
+					break;
+				_state = SYNC;
+				handlePacket();
+				break;
+			}
+		}
+	}
+	return false;
+}
+
+void RGBMatrixSerial::handlePacket() {
+	const uint8_t* payload = (const uint8_t*)_payload;
+	uint8_t type = _header[1];
+	uint8_t sequence = _header[2];
+	uint16_t crc = rgbmatrix_crc16(0xFFFF, _header + 1, RGBMATRIX_SERIAL_HEADER - 1);
+	crc = rgbmatrix_crc16(crc, payload, _length);
+	if (crc != (payload[_length] | (payload[_length + 1] << 8))) {
+		_stats.crcErrors++;
+		nak(RGBMATRIX_SERIAL_NAK_CRC);
+		return;
+	}
+
+	if (type == RGBMATRIX_SERIAL_HELLO) {
+		rgbmatrix_serial_info info;
+		info.width = RGBMatrix.getWidth();
+		info.height = RGBMatrix.getHeight();
+		info.colorDepth = RGBMatrix.getColorDepth();
+		info.window = RGBMATRIX_SERIAL_WINDOW;
+		info.maxPayload = RGBMATRIX_SERIAL_PAYLOAD;
+		info.frameSize = RGBMatrix.getFrameSize();
+		info.layoutSignature = RGBMatrix.getLayoutSignature();
+		_expected = sequence + 1;
+		_nakSent = false;
+		reply(RGBMATRIX_SERIAL_INFO, sequence, (const uint8_t*)&info, sizeof(info));
+		return;
+	}
+
+	if (sequence != _expected) {
+		// Sent again because its ACK was lost : acknowledge without handling it twice
+		if ((uint8_t)(_expected - sequence) <= RGBMATRIX_SERIAL_WINDOW)
+			reply(RGBMATRIX_SERIAL_ACK, _expected - 1);
+		else {
+			_stats.sequenceErrors++;
+			nak(RGBMATRIX_SERIAL_NAK_SEQUENCE);
+		}
+		return;
+	}
+	_expected++;
+	_nakSent = false;
+
+	bool valid;
+	switch (type) {
+		case RGBMATRIX_SERIAL_RECT:
+			valid = writeRect(payload, _length);
+			break;
+		case RGBMATRIX_SERIAL_PLANES:
+			valid = writePlanes(payload, _length);
+			break;
+		case RGBMATRIX_SERIAL_PALETTE:
+			valid = writePalette(payload, _length);
+			break;
+		case RGBMATRIX_SERIAL_SHOW:
+			// Acknowledged by update() after the swap
+			_stats.packets++;
+			_swapPending = true;
+			_swapSequence = sequence;
+			_swapFlags = _length ? payload[0] : 0;
+			return;
+		default:
+			valid = false;
+	}
+	// An invalid packet is skipped, not sent again
+	if (valid)
+		_stats.packets++;
+	else
+		_stats.invalid++;
+	reply(RGBMATRIX_SERIAL_ACK, sequence);
+}
+
+bool RGBMatrixSerial::writeRect(const uint8_t* data, uint16_t length) {
+	if (length < 12)
+		return false;
+	int16_t x = data[0] | (data[1] << 8);
+	int16_t y = data[2] | (data[3] << 8);
+	uint16_t w = data[4] | (data[5] << 8);
+	uint16_t h = data[6] | (data[7] << 8);
+	uint8_t format = data[8];
+	uint32_t first = data[10] | (data[11] << 8);
+	uint8_t pixelSize = format == RGBMATRIX_SERIAL_RGB888 ? 3 : format == RGBMATRIX_SERIAL_RGB565 ? 2 : 1;
+	uint32_t count = (length - 12) / pixelSize;
+	if ((format > RGBMATRIX_SERIAL_INDEXED) || !w || (first + count > (uint32_t)w * h)
+		|| ((format == RGBMATRIX_SERIAL_INDEXED) && !_palette))
+		return false;
+	data += 12;
+
+	// Row runs of the rectangle, out of the panel parts are clipped by writeRGB888()
+	uint16_t col = first % w;
+	int16_t row = y + first / w;
+	while (count) {
+		uint16_t n = w - col;
+		if (n > count)
+			n = count;
+		if (format == RGBMATRIX_SERIAL_RGB888)
+			RGBMatrix.writeRGB888(x + col, row, data, n);
+		else {
+			for (uint16_t done = 0; done < n; ) {
+				uint16_t chunk = n - done > RGBMATRIX_SERIAL_CHUNK ? RGBMATRIX_SERIAL_CHUNK : n - done;
+				if (format == RGBMATRIX_SERIAL_RGB565) {
+					uint16_t rgb565[RGBMATRIX_SERIAL_CHUNK];
+					for (uint16_t i = 0; i < chunk; i++)
+						rgb565[i] = data[2 * (done + i)] | (data[2 * (done + i) + 1] << 8);
+					RGBMatrix.writeRGB565(x + col + done, row, rgb565, chunk);
+				}
+				else {
+					uint8_t rgb[RGBMATRIX_SERIAL_CHUNK * 3];
+					for (uint16_t i = 0; i < chunk; i++)
+						memcpy(rgb + 3 * i, _palette + 3 * data[done + i], 3);
+					RGBMatrix.writeRGB888(x + col + done, row, rgb, chunk);
+				}
+				done += chunk;
+			}
+		}
+		data += n * pixelSize;
+		count -= n;
+		col = 0;
+		row++;
+	}
+	return true;
+}
+
+bool RGBMatrixSerial::writePlanes(const uint8_t* data, uint16_t length) {
+	// Word copy : the frame buffers may be in IRAM
+	if (length < 4)
+		return false;
+	uint32_t offset = *(const uint32_t*)data;
+	length -= 4;
+	if ((offset & 3) || (length & 3) || (offset + length > RGBMatrix.getFrameSize()))
+		return false;
+	const uint32_t* src = (const uint32_t*)(data + 4);
+	uint32_t* dst = (uint32_t*)(RGBMatrix.getEditBuffer() + offset);
+	for (uint16_t i = 0; i < length / 4; i++)
+		dst[i] = src[i];
+	return true;
+}
+
+bool RGBMatrixSerial::writePalette(const uint8_t* data, uint16_t length) {
+	if ((length < 4) || ((length - 1) % 3) || (data[0] + (length - 1) / 3 > 256))
+		return false;
+	if (!_palette) {
+		_palette = new (std::nothrow) uint8_t[256 * 3];
+		if (!_palette)
+			return false;
+		memset(_palette, 0, 256 * 3);
+	}
+	memcpy(_palette + 3 * data[0], data + 1, length - 1);
+	return true;
+}
+
+void RGBMatrixSerial::reply(uint8_t type, uint8_t sequence, const uint8_t* payload, uint16_t length) {
+	uint8_t header[RGBMATRIX_SERIAL_HEADER] = {RGBMATRIX_SERIAL_SYNC, type, sequence, (uint8_t)length, (uint8_t)(length >> 8)};
+	uint16_t crc = rgbmatrix_crc16(0xFFFF, header + 1, RGBMATRIX_SERIAL_HEADER - 1);
+	crc = rgbmatrix_crc16(crc, payload, length);
+	uint8_t crcBytes[RGBMATRIX_SERIAL_CRC] = {(uint8_t)crc, (uint8_t)(crc >> 8)};
+	_stream->write(header, sizeof(header));
+	if (length)
+		_stream->write(payload, length);
+	_stream->write(crcBytes, sizeof(crcBytes));
+}
+
+void RGBMatrixSerial::nak(uint8_t reason) {
+	if (_nakSent)
+		return;
+	_nakSent = true;
+	reply(RGBMATRIX_SERIAL_NAK, _expected, &reason, 1);
+}
@@ -0,0 +1,109 @@
+#ifndef RGBMatrixSerial_H
+#define RGBMatrixSerial_H
+
+#include <Stream.h>
+#include "ESP8266RGBMatrix.h"
+
+// Packet : sync, type, sequence, payload length (16 bits LE), payload, CRC-16/CCITT (LE) of type..payload
+#define RGBMATRIX_SERIAL_SYNC		0xA5
+#define RGBMATRIX_SERIAL_HEADER		5
+#define RGBMATRIX_SERIAL_CRC		2
+
+// Largest payload accepted, the RX buffer must hold window packets : Serial.setRxBufferSize()
+#ifndef RGBMATRIX_SERIAL_PAYLOAD
+#define RGBMATRIX_SERIAL_PAYLOAD	1024
+#endif
+#ifndef RGBMATRIX_SERIAL_WINDOW
+#define RGBMATRIX_SERIAL_WINDOW		4
+#endif
+
+// Host -> panel
+#define RGBMATRIX_SERIAL_HELLO		0x01	// Empty, answered by INFO. Any sequence, the next one is expected after it
+#define RGBMATRIX_SERIAL_RECT		0x10	// x, y, w, h (16 bits), format, 0, first pixel in the rectangle (16 bits), pixels row major
+#define RGBMATRIX_SERIAL_PLANES		0x20	// Offset in the frame (32 bits), bitplanes : offset and length multiple of 4
+#define RGBMATRIX_SERIAL_PALETTE	0x30	// First index, RGB888 entries
+#define RGBMATRIX_SERIAL_SHOW		0x40	// Flags : swap when the current frame has been entirely shown
+// Panel -> host, sequence of the packet answered
+#define RGBMATRIX_SERIAL_INFO		0x81	// rgbmatrix_serial_info
+#define RGBMATRIX_SERIAL_ACK		0x82	// Packets up to this one are handled
+#define RGBMATRIX_SERIAL_NAK		0x83	// Reason, the sequence is the one expected : send again from there
+
+#define RGBMATRIX_SERIAL_RGB888		0
+#define RGBMATRIX_SERIAL_RGB565		1		// LE
+#define RGBMATRIX_SERIAL_INDEXED	2		// Palette index
+
+#define RGBMATRIX_SERIAL_SHOW_COPY	0x01	// Copy the new frame to the edit buffer (dirty rectangles on double buffering)
+
+#define RGBMATRIX_SERIAL_NAK_CRC		1
+#define RGBMATRIX_SERIAL_NAK_SEQUENCE	2
+#define RGBMATRIX_SERIAL_NAK_INVALID	3
+
+struct rgbmatrix_serial_info {
+	uint16_t width;
+	uint16_t height;
+	uint8_t colorDepth;
+	uint8_t window;				// Packets the host may send before the first one is acknowledged
+	uint16_t maxPayload;
+	uint32_t frameSize;			// ESP8266RGBMatrix::getFrameSize(), for PLANES
+	uint32_t layoutSignature;	// ESP8266RGBMatrix::getLayoutSignature(), PLANES must be encoded with the same one
+};
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), shared with the host sender
+static inline uint16_t rgbmatrix_crc16(uint16_t crc, const uint8_t* data, uint32_t length) {
+	while (length--) {
+		uint8_t x = (crc >> 8) ^ *data++;
+		x ^= x >> 4;
+		crc = (crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x;
+	}
+	return crc;
+}
+
+// Frames pushed by a host over a serial link (extras/tools/serial_send.cpp) : pixels are encoded
+// straight into the edit buffer with writeRGB888(), bitplanes are copied. Packets are acknowledged
+// once handled, the host keeps at most window packets in flight and goes back to the sequence
+// of a NAK. A SHOW is acknowledged after the swap, nothing else is read while it waits.
+class RGBMatrixSerial {
+public:
+	struct serialStats {
+		uint32_t packets;		// Packets handled
+		uint32_t frames;		// Frames shown
+		uint32_t crcErrors;
+		uint32_t sequenceErrors;// Packets after a lost one, ignored
+		uint32_t invalid;		// Packets not understood
+	};
+
+	RGBMatrixSerial();
+	~RGBMatrixSerial();
+	bool begin(Stream &stream);				// false if the payload buffer can't be allocated
+	void end();
+	bool update();							// Call from loop(), true when a frame was shown
+	void getStats(serialStats &stats)		{stats = _stats;};
+	void resetStats()						{memset(&_stats, 0, sizeof(_stats));};
+
+private:
+	enum serial_states { SYNC, HEADER, PAYLOAD };
+
+	void handlePacket();
+	bool writeRect(const uint8_t* data, uint16_t length);
+	bool writePlanes(const uint8_t* data, uint16_t length);
+	bool writePalette(const uint8_t* data, uint16_t length);
+	void reply(uint8_t type, uint8_t sequence, const uint8_t* payload = nullptr, uint16_t length = 0);
+	void nak(uint8_t reason);
+
+	Stream* _stream;
+	serial_states _state;
+	uint8_t _header[RGBMATRIX_SERIAL_HEADER];
+	uint32_t* _payload;						// Word aligned for the bitplanes, CRC at the end
+	uint16_t _received;
+	uint16_t _length;
+	uint8_t* _palette;						// 256 RGB888 entries, allocated by the first PALETTE
+	uint8_t _expected;						// Next sequence
+	bool _nakSent;							// Only one NAK until the expected packet comes
+	bool _swapPending;
+	uint8_t _swapSequence;
+	uint8_t _swapFlags;
+	uint32_t _shownFrame;
+	serialStats _stats;
+};
+
+#endif /*RGBMatrixSerial_H*/
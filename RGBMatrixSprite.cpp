@@ -0,0 +1,177 @@
+#include "RGBMatrixSprite.h"
+
+// 8 pixels of a bit row from pixel s (-8 < s < width)
+static inline uint8_t extract8(const uint8_t* row, int16_t s) {
+	if (s < 0)
+		return row[0] << -s;
+	return (row[s >> 3] | (row[(s >> 3) + 1] << 8)) >> (s & 7);
+}
+
+RGBMatrixSprite::RGBMatrixSprite() {
+	_bits = nullptr;
+	_width = 0;
+	_height = 0;
+}
+
+RGBMatrixSprite::~RGBMatrixSprite() {
+	end();
+}
+
+void RGBMatrixSprite::end() {
+	delete[] _bits;
+	_bits = nullptr;
+}
+
+bool RGBMatrixSprite::alloc(uint16_t width, uint16_t height) {
+	end();
+	_width = width;
+	_height = height;
+	_colorDepth = RGBMatrix._colorDepth;
+	_rowBytes = (width + 7) / 8 + 1;
+	_rowSize = _rowBytes * (1 + 3 * _colorDepth);
+	if (!width || !height || !_colorDepth)
+		return false;
+	_bits = new (std::nothrow) uint8_t[_rowSize * height];
+	if (_bits)
+		memset(_bits, 0, _rowSize * height);
+	return _bits;
+}
+
+void RGBMatrixSprite::encodeColor(uint8_t r, uint8_t g, uint8_t b, uint8_t* values) {
+	// Same color processing as the driver
+	RGBMatrix.applyColorSettings(r, g, b);
+	values[0] = r >> (8 - _colorDepth);
+	values[1] = g >> (8 - _colorDepth);
+	values[2] = b >> (8 - _colorDepth);
+}
+
+void RGBMatrixSprite::setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) {
+	if (!_bits || (x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+		return;
+	uint8_t values[3];
+	encodeColor(r, g, b, values);
+	uint8_t* row = _bits + y * _rowSize + (x >> 3);
+	uint8_t bit = 1 << (x & 7);
+	*row |= bit;
+	row += _rowBytes;
+	for (uint8_t c = 0; c < 3; c++)
+		for (uint8_t p = 0; p < _colorDepth; p++, row += _rowBytes) {
+			if (values[c] & (1 << p))
+				*row |= bit;
+			else
+				*row &= ~bit;
+		}
+}
+
+void RGBMatrixSprite::fill(uint8_t r, uint8_t g, uint8_t b) {
+	if (!_bits)
+		return;
+	uint8_t values[3];
+	encodeColor(r, g, b, values);
+	for (uint16_t y = 0; y < _height; y++) {
+		// Mask bits past the width stay clear, draw() reads them
+		uint8_t* row = _bits + y * _rowSize;
+		memset(row, 0xFF, _width / 8);
+		row[_width / 8] = (1 << (_width & 7)) - 1;
+		row += _rowBytes;
+		for (uint8_t c = 0; c < 3; c++)
+			for (uint8_t p = 0; p < _colorDepth; p++, row += _rowBytes)
+				memset(row, (values[c] & (1 << p)) ? 0xFF : 0x00, _rowBytes);
+	}
+}
+
+bool RGBMatrixSprite::begin(uint16_t width, uint16_t height, const uint8_t* rgb, const uint8_t* mask) {
+	if (!alloc(width, height))
+		return false;
+	uint16_t maskBytes = (width + 7) / 8;
+	for (uint16_t y = 0; y < height; y++)
+		for (uint16_t x = 0; x < width; x++, rgb += 3)
+			if (!mask || (pgm_read_byte(mask + y * maskBytes + x / 8) & (0x80 >> (x & 7))))
+				setPixel(x, y, pgm_read_byte(rgb), pgm_read_byte(rgb + 1), pgm_read_byte(rgb + 2));
+	return true;
+}
+
+bool RGBMatrixSprite::begin(uint16_t width, uint16_t height, const uint16_t* rgb565, uint16_t transparent) {
+	if (!alloc(width, height))
+		return false;
+	for (uint16_t y = 0; y < height; y++)
+		for (uint16_t x = 0; x < width; x++, rgb565++) {
+			uint16_t color = pgm_read_word(rgb565);
+			if (color == transparent)
+				continue;
+			uint8_t r, g, b;
+			rgb565to888(color, r, g, b);
+			setPixel(x, y, r, g, b);
+		}
+	return true;
+}
+
+bool RGBMatrixSprite::begin(uint16_t width, uint16_t height, const uint8_t* bitmap, uint8_t r, uint8_t g, uint8_t b) {
+	if (!alloc(width, height))
+		return false;
+	uint8_t values[3];
+	encodeColor(r, g, b, values);
+	uint16_t bitmapBytes = (width + 7) / 8;
+	for (uint16_t y = 0; y < height; y++) {
+		uint8_t* row = _bits + y * _rowSize;
+		for (uint16_t x = 0; x < width; x++)
+			if (pgm_read_byte(bitmap + y * bitmapBytes + x / 8) & (0x80 >> (x & 7)))
+				row[x >> 3] |= 1 << (x & 7);
+		// A bit row is the mask where the color has this bit, else clear
+		uint8_t* bitRow = row + _rowBytes;
+		for (uint8_t c = 0; c < 3; c++)
+			for (uint8_t p = 0; p < _colorDepth; p++, bitRow += _rowBytes)
+				if (values[c] & (1 << p))
+					memcpy(bitRow, row, _rowBytes);
+	}
+	return true;
+}
+
+bool RGBMatrixSprite::begin(uint16_t width, uint16_t height, bool opaque) {
+	if (!alloc(width, height))
+		return false;
+	if (opaque)
+		fill(0, 0, 0);
+	return true;
+}
+
+void RGBMatrixSprite::draw(int16_t x, int16_t y, uint8_t op) {
+	ESP8266RGBMatrix &matrix = RGBMatrix;
+	if (!_bits || !matrix._isBegin || (_colorDepth != matrix._colorDepth))
+		return;
+	int16_t x0 = x < 0 ? 0 : x;
+	int16_t x1 = x + _width > matrix._width ? matrix._width : x + _width;
+	if (x0 >= x1)
+		return;
+	if (!matrix._groupMapValid)
+		matrix.initGroupMap();
+
+	uint8_t planeBits[3 * 8];
+	uint8_t current[3 * 8];
+	for (uint16_t sy = 0; sy < _height; sy++) {
+		int16_t dy = y + sy;
+		if ((dy < 0) || (dy >= matrix._height))
+			continue;
+		const uint8_t* row = _bits + sy * _rowSize;
+		for (int16_t gx = x0 & ~7; gx < x1; gx += 8) {
+			// Source pixel of the group pixel 0, the panel edge clips the last group
+			int16_t s = gx - x;
+			uint8_t pixels = extract8(row, s);
+			if (gx + 8 > matrix._width)
+				pixels &= (1 << (matrix._width - gx)) - 1;
+			if (!pixels)
+				continue;
+			const uint8_t* bitRow = row + _rowBytes;
+			for (uint8_t c = 0; c < 3; c++)
+				for (uint8_t p = 0; p < _colorDepth; p++, bitRow += _rowBytes)
+					planeBits[8 * c + p] = extract8(bitRow, s);
+			if (op != ROP_COPY) {
+				matrix.readGroup(matrix._edit_buffer, gx, dy, current);
+				for (uint8_t c = 0; c < 3; c++)
+					for (uint8_t p = 0; p < _colorDepth; p++)
+						planeBits[8 * c + p] = rasterOp(op, current[8 * c + p], planeBits[8 * c + p]);
+			}
+			matrix.writeGroup(matrix._edit_buffer, gx, dy, planeBits, pixels);
+		}
+	}
+}
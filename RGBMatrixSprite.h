@@ -0,0 +1,44 @@
+#ifndef RGBMatrixSprite_H
+#define RGBMatrixSprite_H
+
+#include "ESP8266RGBMatrix.h"
+
+// Sprite encoded once into bit rows : for each sprite row, the opacity mask then one row per color
+// and bitplane (pixel i in bit i). draw() shifts them to any x and merges 8 pixels at a time into
+// the bitplanes through the driver group map, so a 16x16 sprite is a few words per plane and row
+// instead of 256 setPixel().
+// The encoding depends on the color depth and the color settings : begin() again after changing them.
+class RGBMatrixSprite {
+public:
+	RGBMatrixSprite();
+	~RGBMatrixSprite();
+	// RGB888 pixels, row major. mask : 1 bit per pixel, rows padded to a byte, MSB first (drawBitmap() format),
+	// nullptr for an opaque sprite. RAM or PROGMEM
+	bool begin(uint16_t width, uint16_t height, const uint8_t* rgb, const uint8_t* mask = nullptr);
+	// RGB565 pixels, the transparent color is not drawn
+	bool begin(uint16_t width, uint16_t height, const uint16_t* rgb565, uint16_t transparent);
+	// Single color bitmap, drawBitmap() format : the color is encoded once and copied into the bit rows by mask
+	bool begin(uint16_t width, uint16_t height, const uint8_t* bitmap, uint8_t r, uint8_t g, uint8_t b);
+	// Blank sprite to draw into : transparent, or black and opaque
+	bool begin(uint16_t width, uint16_t height, bool opaque);
+	void end();
+	void setPixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);	// Opaque pixel
+	void fill(uint8_t r, uint8_t g, uint8_t b);		// Every pixel, opaque
+	void draw(int16_t x, int16_t y, uint8_t op = ROP_COPY);	// raster_ops between the opaque pixels and the edit buffer
+	uint16_t getWidth()						{return _width;};
+	uint16_t getHeight()					{return _height;};
+	uint32_t getDataSize()					{return _bits ? _rowSize * _height : 0;};	// Bytes of bit rows
+
+private:
+	bool alloc(uint16_t width, uint16_t height);
+	void encodeColor(uint8_t r, uint8_t g, uint8_t b, uint8_t* values);
+
+	uint16_t _width;
+	uint16_t _height;
+	uint8_t _colorDepth;
+	uint16_t _rowBytes;						// Bytes of a bit row, one more for the shift
+	uint32_t _rowSize;						// Bytes of a sprite row : mask and 3 * _colorDepth bit rows
+	uint8_t* _bits;
+};
+
+#endif /*RGBMatrixSprite_H*/
@@ -0,0 +1,171 @@
+#include "RGBMatrixStream.h"
+
+RGBMatrixStream::RGBMatrixStream(uint16_t bufferSize) {
+	_ring = nullptr;
+	_ringSize = bufferSize;
+	_frameCount = 0;
+	_frameDelay = 0;
+	_underruns = 0;
+}
+
+RGBMatrixStream::~RGBMatrixStream() {
+	end();
+}
+
+bool RGBMatrixStream::begin(fs::File file) {
+	end();
+	if (!file)
+		return false;
+
+	// Both formats start with their magic
+	rgbmatrix_asset_header asset;
+	rgbmatrix_delta_header delta;
+	uint32_t magic = 0;
+	if (file.read((uint8_t*)&magic, sizeof(magic)) != sizeof(magic))
+		return false;
+	file.seek(0);
+	if (magic == RGBMATRIX_ASSET_MAGIC) {
+		if ((file.read((uint8_t*)&asset, sizeof(asset)) != sizeof(asset)) || !RGBMatrixAsset::checkHeader(asset))
+			return false;
+		_raw = true;
+		_dataStart = sizeof(asset);
+		_frameCount = asset.frameCount;
+		_frameDelay = asset.frameDelay;
+		_frameSize = asset.frameSize;
+	}
+	else {
+		if ((file.read((uint8_t*)&delta, sizeof(delta)) != sizeof(delta)) || !RGBMatrixDelta::checkHeader(delta))
+			return false;
+		_raw = false;
+		_dataStart = sizeof(delta);
+		_frameCount = delta.frameCount;
+		_frameDelay = delta.frameDelay;
+		_frameSize = delta.frameSize;
+	}
+	if (!_frameCount)
+		return false;
+
+	_ring = new (std::nothrow) uint8_t[_ringSize];
+	if (!_ring)
+		return false;
+	_file = file;
+	_head = _tail = _level = 0;
+	_state = RECORD;
+	_recordLength = 0;
+	_nextFrame = millis();
+	_shownFrame = RGBMatrix.getFrameCount() - 1;
+	_late = false;
+	_underruns = 0;
+	return true;
+}
+
+void RGBMatrixStream::end() {
+	if (_ring)
+		_file.close();
+	delete[] _ring;
+	_ring = nullptr;
+}
+
+void RGBMatrixStream::consume(uint16_t length) {
+	_head = (_head + length) % _ringSize;
+	_level -= length;
+}
+
+void RGBMatrixStream::fill() {
+	uint16_t budget = RGBMATRIX_STREAM_CHUNK;
+	while (budget && (_level < _ringSize)) {
+		// The records loop : after the last one the file goes on with the first one
+		if (!_file.available())
+			_file.seek(_dataStart);
+		uint16_t length = _ringSize - _tail;
+		if (length > _ringSize - _level)	length = _ringSize - _level;
+		if (length > budget)				length = budget;
+		uint16_t read = _file.read(_ring + _tail, length);
+		if (!read)
+			break;
+		_tail = (_tail + read) % _ringSize;
+		_level += read;
+		budget -= read;
+	}
+}
+
+void RGBMatrixStream::decode() {
+	while (_ring && (_state != READY) && _level) {
+		uint16_t contiguous = _ringSize - _head;
+		if (contiguous > _level)
+			contiguous = _level;
+		switch (_state) {
+			case RECORD:
+				if (_raw) {
+					_decoder.begin(RGBMatrix.getEditBuffer(), _frameSize, RGBMATRIX_DELTA_KEYFRAME, _frameSize, true);
+					_padding = ((_frameSize + 3) & ~3) - _frameSize;
+				}
+				else {
+					// The record header may be split by the end of the ring
+					while ((_recordLength < 4) && _level) {
+						_record[_recordLength++] = _ring[_head];
+						consume(1);
+					}
+					if (_recordLength < 4)
+						return;
+					uint32_t length = _record[1] | (_record[2] << 8) | ((uint32_t)_record[3] << 16);
+					_decoder.begin(RGBMatrix.getEditBuffer(), _frameSize, _record[0], length);
+					_padding = ((length + 3) & ~3) - length;
+					_recordLength = 0;
+				}
+				_state = PAYLOAD;
+				break;
+			case PAYLOAD:
+				consume(_decoder.feed(_ring + _head, contiguous));
+				// Corrupted file
+				if (_decoder.failed()) {
+					end();
+					return;
+				}
+				if (_decoder.done())
+					_state = _padding ? PADDING : READY;
+				break;
+			case PADDING:
+				if (contiguous > _padding)
+					contiguous = _padding;
+				consume(contiguous);
+				_padding -= contiguous;
+				if (!_padding)
+					_state = READY;
+				break;
+			case READY:
+				break;
+		}
+	}
+}
+
+bool RGBMatrixStream::update() {
+	if (!_ring)
+		return false;
+	fill();
+	decode();
+	if ((int32_t)(millis() - _nextFrame) < 0)
+		return false;
+	if (_state != READY) {
+		if (!_late)
+			_underruns++;
+		_late = true;
+		return false;
+	}
+	// Wait for the previous frame to be entirely refreshed once
+	if (RGBMatrix.getFrameCount() == _shownFrame)
+		return false;
+	RGBMatrix.showBuffer();
+	_shownFrame = RGBMatrix.getFrameCount();
+	_late = false;
+
+	// Late by more than a frame : restart the schedule instead of rushing to catch up
+	_nextFrame += _frameDelay;
+	if ((int32_t)(millis() - _nextFrame) > _frameDelay)
+		_nextFrame = millis() + _frameDelay;
+
+	// The next frame is decoded in the new back buffer while this one is shown
+	_state = RECORD;
+	decode();
+	return true;
+}
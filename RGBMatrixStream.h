@@ -0,0 +1,66 @@
+#ifndef RGBMatrixStream_H
+#define RGBMatrixStream_H
+
+#include <FS.h>
+#include "ESP8266RGBMatrix.h"
+#include "RGBMatrixAsset.h"
+#include "RGBMatrixDelta.h"
+
+// Read-ahead ring size
+#ifndef RGBMATRIX_STREAM_BUFFER
+#define RGBMATRIX_STREAM_BUFFER 2048
+#endif
+
+// Maximum bytes read from the file by one update(), bounds the time spent in the file system
+#ifndef RGBMATRIX_STREAM_CHUNK
+#define RGBMATRIX_STREAM_CHUNK 512
+#endif
+
+// Plays an animation file from LittleFS/SPIFFS : RGBMatrixAsset (rgbmatrix_asset -b) or
+// RGBMatrixDelta (rgbmatrix_delta -b). The file is read a chunk at a time into a small ring and
+// decoded into the back buffer while the current frame is shown, swaps wait for a complete refresh frame.
+// The refresh interrupt runs from IRAM so the flash reads never stall it.
+class RGBMatrixStream {
+public:
+	RGBMatrixStream(uint16_t bufferSize = RGBMATRIX_STREAM_BUFFER);
+	~RGBMatrixStream();
+	bool begin(fs::File file);				// false if the file doesn't match the current layout
+	void end();
+	bool update();							// Call from loop(), true when a new frame was shown
+	uint16_t getFrameCount()				{return _frameCount;};
+	uint16_t getFrameDelay()				{return _frameDelay;};
+	uint32_t getUnderruns()					{return _underruns;};	// Frames shown late because the data was not there
+
+private:
+	enum stream_states { RECORD, PAYLOAD, PADDING, READY };
+
+	void fill();
+	void decode();
+	void consume(uint16_t length);
+
+	fs::File _file;
+	uint8_t* _ring;
+	uint16_t _ringSize;
+	uint16_t _head;							// Next byte to decode
+	uint16_t _tail;							// Next byte to read from the file
+	uint16_t _level;						// Bytes waiting in the ring
+
+	bool _raw;								// RGBMatrixAsset frames
+	uint32_t _dataStart;					// Position of the first frame in the file
+	uint16_t _frameCount;
+	uint16_t _frameDelay;
+	uint32_t _frameSize;
+
+	stream_states _state;
+	uint8_t _record[4];
+	uint8_t _recordLength;
+	uint32_t _padding;
+	RGBMatrixDeltaDecoder _decoder;
+
+	uint32_t _nextFrame;
+	uint32_t _shownFrame;					// RGBMatrix.getFrameCount() at the last swap
+	bool _late;
+	uint32_t _underruns;
+};
+
+#endif /*RGBMatrixStream_H*/
@@ -0,0 +1,170 @@
+#include "RGBMatrixTransition.h"
+
+RGBMatrixTransition::RGBMatrixTransition() {
+	_from = nullptr;
+	_to = nullptr;
+	_order = nullptr;
+	_redirected = false;
+	_orderMode = 0xFF;
+	_running = false;
+}
+
+RGBMatrixTransition::~RGBMatrixTransition() {
+	end();
+}
+
+void RGBMatrixTransition::end() {
+	drawDone();
+	delete[] _from;
+	delete[] _to;
+	delete[] _order;
+	_from = nullptr;
+	_to = nullptr;
+	_order = nullptr;
+	_orderMode = 0xFF;
+	_running = false;
+}
+
+bool RGBMatrixTransition::begin() {
+	end();
+	// Copied by words as the frame buffers
+	uint32_t size = (RGBMatrix.getFrameSize() + 3) & ~3;
+	if (!size)
+		return false;
+	_from = new (std::nothrow) uint8_t[size];
+	_to = new (std::nothrow) uint8_t[size];
+	if (!_from || !_to) {
+		end();
+		return false;
+	}
+	return true;
+}
+
+bool RGBMatrixTransition::start(uint8_t mode, uint16_t frames) {
+	ESP8266RGBMatrix &matrix = RGBMatrix;
+	if (!_from)
+		return false;
+	drawDone();
+	uint32_t size = matrix.getFrameSize();
+	if ((mode != TRANSITION_FADE) && (mode != _orderMode)) {
+		if (!_order)
+			_order = new (std::nothrow) uint8_t[(size + 3) & ~3];
+		if (!_order)
+			return false;
+		buildOrder(mode);
+	}
+	ESP8266RGBMatrix::copyWords(_from, matrix._edit_buffer, size);
+	ESP8266RGBMatrix::copyWords(_to, matrix._edit_buffer, size);
+	_mode = mode;
+	_frames = frames ? frames : 1;
+	_frame = 0;
+	_running = true;
+	return true;
+}
+
+void RGBMatrixTransition::drawFrom() {
+	if (!_from)
+		return;
+	RGBMatrix.setDrawTarget(_from);
+	_redirected = true;
+}
+
+void RGBMatrixTransition::drawTo() {
+	if (!_to)
+		return;
+	RGBMatrix.setDrawTarget(_to);
+	_redirected = true;
+}
+
+void RGBMatrixTransition::drawDone() {
+	if (!_redirected)
+		return;
+	RGBMatrix.setDrawTarget(nullptr);
+	_redirected = false;
+}
+
+// Order values as gray pixels, written without the color settings : the planes hold their bits as they are
+void RGBMatrixTransition::buildOrder(uint8_t mode) {
+	ESP8266RGBMatrix &matrix = RGBMatrix;
+	if (!matrix._groupMapValid)
+		matrix.initGroupMap();
+	uint16_t levels = 1 << matrix._colorDepth;
+	uint32_t random = 2463534242UL;
+	uint8_t planeBits[3 * 8];
+	for (int16_t y = 0; y < matrix._height; y++)
+		for (int16_t gx = 0; gx < matrix._width; gx += 8) {
+			for (uint8_t p = 0; p < matrix._colorDepth; p++)
+				planeBits[p] = 0;
+			for (uint8_t i = 0; (i < 8) && (gx + i < matrix._width); i++) {
+				uint8_t order;
+				if (mode == TRANSITION_WIPE_RIGHT)
+					order = (uint32_t)(gx + i) * levels / matrix._width;
+				else if (mode == TRANSITION_WIPE_DOWN)
+					order = (uint32_t)y * levels / matrix._height;
+				else {
+					// xorshift32
+					random ^= random << 13;
+					random ^= random >> 17;
+					random ^= random << 5;
+					order = random & (levels - 1);
+				}
+				for (uint8_t p = 0; p < matrix._colorDepth; p++)
+					if ((order >> p) & 0x01)
+						planeBits[p] |= 1 << i;
+			}
+			for (uint8_t p = 0; p < matrix._colorDepth; p++)
+				planeBits[8 + p] = planeBits[16 + p] = planeBits[p];
+			uint8_t n = matrix._width - gx < 8 ? matrix._width - gx : 8;
+			matrix.writeGroup(_order, gx, y, planeBits, (1 << n) - 1);
+		}
+	_orderMode = mode;
+}
+
+// Edit buffer = incoming frame where order < level, else outgoing frame
+void RGBMatrixTransition::select(uint8_t level) {
+	ESP8266RGBMatrix &matrix = RGBMatrix;
+	uint32_t planeSize = matrix._bufferSize;
+	uint8_t depth = matrix._colorDepth;
+	// 4 bytes of each plane at a time, or 1 when the planes are not word aligned
+	uint8_t step = (planeSize & 3) ? 1 : 4;
+	for (uint32_t offset = 0; offset < planeSize; offset += step) {
+		// Bit sliced order < level, most significant plane first
+		uint32_t less = 0;
+		uint32_t equal = 0xFFFFFFFF;
+		for (int8_t p = depth - 1; p >= 0; p--) {
+			uint32_t o = p * planeSize + offset;
+			uint32_t order = step == 4 ? *(const uint32_t*)(_order + o) : matrix.readByte(_order, o);
+			if ((level >> p) & 0x01) {
+				less |= equal & ~order;
+				equal &= order;
+			}
+			else
+				equal &= ~order;
+		}
+		for (uint8_t p = 0; p < depth; p++) {
+			uint32_t o = p * planeSize + offset;
+			if (step == 4)
+				*(uint32_t*)(matrix._edit_buffer + o) = (*(const uint32_t*)(_from + o) & ~less) | (*(const uint32_t*)(_to + o) & less);
+			else
+				matrix.writeBits(matrix._edit_buffer, o, (matrix.readByte(_from, o) & ~less) | (matrix.readByte(_to, o) & less), 0xFF);
+		}
+	}
+}
+
+bool RGBMatrixTransition::update() {
+	ESP8266RGBMatrix &matrix = RGBMatrix;
+	if (!_running)
+		return false;
+	drawDone();
+	_frame++;
+	if (_frame >= _frames) {
+		ESP8266RGBMatrix::copyWords(matrix._edit_buffer, _to, matrix.getFrameSize());
+		_running = false;
+		return false;
+	}
+	if (_mode == TRANSITION_FADE)
+		matrix.blendFrames(_from, _to, (uint32_t)_frame * 255 / _frames);
+	else
+		select((uint32_t)_frame * (1 << matrix._colorDepth) / _frames);
+	return true;
+}
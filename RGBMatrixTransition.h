@@ -0,0 +1,43 @@
+#ifndef RGBMatrixTransition_H
+#define RGBMatrixTransition_H
+
+#include "ESP8266RGBMatrix.h"
+
+enum transition_modes {TRANSITION_FADE, TRANSITION_WIPE_RIGHT, TRANSITION_WIPE_DOWN, TRANSITION_DISSOLVE};
+
+// Transition from an outgoing frame to an incoming one, both kept encoded in their own buffers : drawing is
+// redirected to them (setDrawTarget()) between drawFrom() / drawTo() and drawDone(), so both sides can keep animating.
+// update() composes the edit buffer : a fade blends the two frames in one decode, blend, encode pass over the
+// planes (blendFrames()), the wipes and the dissolve select whole pixels through a bitplane mask built from
+// an encoded order frame (a bit sliced comparison, then AND / OR of the planes) and run in 2^colorDepth steps.
+class RGBMatrixTransition {
+public:
+	RGBMatrixTransition();
+	~RGBMatrixTransition();
+	bool begin();							// After RGBMatrix.begin()
+	void end();
+	bool start(uint8_t mode, uint16_t frames);	// The edit buffer becomes the outgoing and incoming frames
+	void drawFrom();						// Drawing goes to the outgoing frame
+	void drawTo();							// Drawing goes to the incoming frame
+	void drawDone();						// Drawing goes to the edit buffer again, before showBuffer() (refused until then)
+	bool update();							// Next transition frame into the edit buffer, false once the incoming frame is shown
+	bool isRunning()						{return _running;};
+	uint8_t* getFrom()						{return _from;};
+	uint8_t* getTo()						{return _to;};
+
+private:
+	void buildOrder(uint8_t mode);
+	void select(uint8_t level);
+
+	uint8_t* _from;
+	uint8_t* _to;
+	uint8_t* _order;						// Encoded frame of the step at which each pixel switches, allocated by the first mask mode
+	bool _redirected;						// Drawing redirected by drawFrom() / drawTo()
+	uint8_t _mode;
+	uint8_t _orderMode;						// Mode _order was built for
+	uint16_t _frames;
+	uint16_t _frame;
+	bool _running;
+};
+
+#endif /*RGBMatrixTransition_H*/
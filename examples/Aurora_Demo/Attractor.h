@@ -28,8 +28,8 @@
 
 class Attractor {
 public:
-    float mass;    // Mass, tied to size
-    float G;       // Gravitational Constant
+    fix16 mass;    // Mass, tied to size
+    fix16 G;       // Gravitational Constant
     PVector location;   // Location
 
     Attractor() {
@@ -40,10 +40,11 @@ public:
 
     PVector attract(Boid m) {
         PVector force = location - m.location;   // Calculate direction of force
-        float d = force.mag();                              // Distance between objects
-        d = constrain(d, 5.0, 32.0);                        // Limiting the distance to eliminate "extreme" results for very close or very far objects
+        fix16 d = force.mag();                              // Distance between objects
+        if (d < 5) d = 5;                                   // Limiting the distance to eliminate "extreme" results for very close or very far objects
+        if (d > 32) d = 32;
         force.normalize();                                  // Normalize vector (distance doesn't matter here, we just want this vector for direction)
-        float strength = (G * mass * m.mass) / (d * d);      // Calculate gravitional force magnitude
+        fix16 strength = (G * mass * m.mass) / (d * d);      // Calculate gravitional force magnitude
         force *= strength;                                  // Get force vector --> magnitude * direction
         return force;
     }
@@ -47,7 +47,6 @@ Ticker display_ticker;
 unsigned long ms_current  = 0;
 unsigned long ms_previous = 0;
 unsigned long ms_animation_max_duration = 10000; // 10 seconds
-unsigned long next_frame = 0;
 
 // This defines the 'on' time of the display is us. The larger this number,
 // the brighter the display. If too large the ESP will crash
@@ -59,6 +58,7 @@ PxMATRIX display(32,16,P_LAT, P_OE,P_A,P_B,P_C);
 
 #include <FastLED.h> // Aurora needs fastled
 
+#include "NoiseField.h"
 #include "Effects.h"
 Effects effects;
 
@@ -69,6 +69,9 @@ Effects effects;
 #include "Patterns.h"
 Patterns patterns;
 
+#include "Scheduler.h"
+Scheduler scheduler(patterns);
+
 // Some standard colors
 uint16_t myRED = display.color565(255, 0, 0);
 uint16_t myGREEN = display.color565(0, 255, 0);
@@ -239,13 +242,9 @@ void loop()
     {
      //  patterns.moveRandom(1);
 
-       patterns.stop();      
-       patterns.move(1);
-       patterns.start();  
- 
-       
-       Serial.print("Changing pattern to:  ");
-       Serial.println(patterns.getCurrentPatternName());
+       // Applied once the current frame is complete
+       scheduler.printCosts();
+       scheduler.move(1);
         
        ms_previous = ms_current;
 
@@ -253,11 +252,9 @@ void loop()
        //effects.RandomPalette();
     }
  
-    if ( next_frame < ms_current)
-    {
-      next_frame = patterns.drawFrame() + ms_current;   
+    // One slice of the frame per loop, shown when complete
+    if (scheduler.run())
       display.showBuffer();  
-    }
 }
 
 void listPatterns() {
@@ -37,19 +37,19 @@ class Boid {
     PVector location;
     PVector velocity;
     PVector acceleration;
-    float maxforce;    // Maximum steering force
-    float maxspeed;    // Maximum speed
+    fix16 maxforce;    // Maximum steering force
+    fix16 maxspeed;    // Maximum speed
 
-    float desiredseparation = 4;
-    float neighbordist = 8;
+    fix16 desiredseparation = 4;
+    fix16 neighbordist = 8;
     byte colorIndex = 0;
-    float mass;
+    fix16 mass;
 
     boolean enabled = true;
 
     Boid() {}
 
-    Boid(float x, float y) {
+    Boid(fix16 x, fix16 y) {
       acceleration = PVector(0, 0);
       velocity = PVector(randomf(), randomf());
       location = PVector(x, y);
@@ -57,16 +57,13 @@ class Boid {
       maxforce = 0.05;
     }
 
-    static float randomf() {
-      return mapfloat(random(0, 255), 0, 255, -.5, .5);
+    // -0.5 to 0.5
+    static fix16 randomf() {
+      return fix16::fromRaw(random(-32768, 32768));
     }
 
-    static float mapfloat(float x, float in_min, float in_max, float out_min, float out_max) {
-      return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
-    }
-
-    void run(Boid boids [], uint8_t boidCount) {
-      flock(boids, boidCount);
+    void run(Boid boids [], BoidGrid &grid) {
+      flock(boids, grid);
       update();
       // wrapAroundBorders();
       // render();
@@ -88,12 +85,12 @@ class Boid {
       acceleration += force;
     }
 
-    void repelForce(PVector obstacle, float radius) {
+    void repelForce(PVector obstacle, fix16 radius) {
       //Force that drives boid away from obstacle.
 
       PVector futPos = location + velocity; //Calculate future position for more effective behavior.
       PVector dist = obstacle - futPos;
-      float d = dist.mag();
+      fix16 d = dist.mag();
 
       if (d <= radius) {
         PVector repelVec = location - obstacle;
@@ -111,14 +108,48 @@ class Boid {
     }
 
     // We accumulate a new acceleration each time based on three rules
-    void flock(Boid boids [], uint8_t boidCount) {
-      PVector sep = separate(boids, boidCount);   // Separation
-      PVector ali = align(boids, boidCount);      // Alignment
-      PVector coh = cohesion(boids, boidCount);   // Cohesion
+    // The neighbours are the boids of the grid cells within reach, visited once for the three rules
+    void flock(Boid boids [], BoidGrid &grid) {
+      PVector separation = PVector(0, 0);
+      PVector velocities = PVector(0, 0);
+      PVector locations = PVector(0, 0);
+      int separationCount = 0;
+      int count = 0;
+      fix16 separationSq = desiredseparation * desiredseparation;
+      fix16 neighborSq = neighbordist * neighbordist;
+      uint8_t column0, row0, column1, row1;
+      grid.range(location, neighbordist > desiredseparation ? neighbordist : desiredseparation, column0, row0, column1, row1);
+      for (uint8_t row = row0; row <= row1; row++) {
+        for (uint8_t column = column0; column <= column1; column++) {
+          for (uint16_t i = grid.first(column, row); i != BOID_NONE; i = grid.next(i)) {
+            Boid &other = boids[i];
+            if (!other.enabled)
+              continue;
+            PVector diff = location - other.location;
+            fix16 dSq = diff.magSq();
+            // 0 when you are yourself
+            if (dSq == 0)
+              continue;
+            if (dSq < separationSq) {
+              // Pointing away from the neighbor, weighted by distance : normalized then divided by d
+              diff /= dSq;
+              separation += diff;
+              separationCount++;
+            }
+            if (dSq < neighborSq) {
+              velocities += other.velocity;
+              locations += other.location;
+              count++;
+            }
+          }
+        }
+      }
+
+      PVector sep = separate(separation, separationCount);
+      PVector ali = align(velocities, count);
+      PVector coh = cohesion(locations, count);
       // Arbitrarily weight these forces
       sep *= 1.5;
-      ali *= 1.0;
-      coh *= 1.0;
       // Add the force vectors to acceleration
       applyForce(sep);
       applyForce(ali);
@@ -126,33 +157,15 @@ class Boid {
     }
 
     // Separation
-    // Method checks for nearby boids and steers away
-    PVector separate(Boid boids [], uint8_t boidCount) {
-      PVector steer = PVector(0, 0);
-      int count = 0;
-      // For every boid in the system, check if it's too close
-      for (int i = 0; i < boidCount; i++) {
-        Boid other = boids[i];
-        if (!other.enabled)
-          continue;
-        float d = location.dist(other.location);
-        // If the distance is greater than 0 and less than an arbitrary amount (0 when you are yourself)
-        if ((d > 0) && (d < desiredseparation)) {
-          // Calculate vector pointing away from neighbor
-          PVector diff = location - other.location;
-          diff.normalize();
-          diff /= d;        // Weight by distance
-          steer += diff;
-          count++;            // Keep track of how many
-        }
-      }
+    // Steers away from the nearby boids, from the sum of the vectors pointing away from them
+    PVector separate(PVector steer, int count) {
       // Average -- divide by how many
       if (count > 0) {
-        steer /= (float) count;
+        steer /= count;
       }
 
       // As long as the vector is greater than 0
-      if (steer.mag() > 0) {
+      if (!steer.isEmpty()) {
         // Implement Reynolds: Steering = Desired - Velocity
         steer.normalize();
         steer *= maxspeed;
@@ -163,22 +176,10 @@ class Boid {
     }
 
     // Alignment
-    // For every nearby boid in the system, calculate the average velocity
-    PVector align(Boid boids [], uint8_t boidCount) {
-      PVector sum = PVector(0, 0);
-      int count = 0;
-      for (int i = 0; i < boidCount; i++) {
-        Boid other = boids[i];
-        if (!other.enabled)
-          continue;
-        float d = location.dist(other.location);
-        if ((d > 0) && (d < neighbordist)) {
-          sum += other.velocity;
-          count++;
-        }
-      }
+    // From the sum of the velocities of the nearby boids, steers to their average velocity
+    PVector align(PVector sum, int count) {
       if (count > 0) {
-        sum /= (float) count;
+        sum /= count;
         sum.normalize();
         sum *= maxspeed;
         PVector steer = sum - velocity;
@@ -191,20 +192,8 @@ class Boid {
     }
 
     // Cohesion
-    // For the average location (i.e. center) of all nearby boids, calculate steering vector towards that location
-    PVector cohesion(Boid boids [], uint8_t boidCount) {
-      PVector sum = PVector(0, 0);   // Start with empty vector to accumulate all locations
-      int count = 0;
-      for (int i = 0; i < boidCount; i++) {
-        Boid other = boids[i];
-        if (!other.enabled)
-          continue;
-        float d = location.dist(other.location);
-        if ((d > 0) && (d < neighbordist)) {
-          sum += other.location; // Add location
-          count++;
-        }
-      }
+    // From the sum of the locations of the nearby boids, steers towards their average location (i.e. center)
+    PVector cohesion(PVector sum, int count) {
       if (count > 0) {
         sum /= count;
         return seek(sum);  // Steer towards the location
@@ -231,11 +220,11 @@ class Boid {
     // STEER = DESIRED MINUS VELOCITY
     void arrive(PVector target) {
       PVector desired = target - location;  // A vector pointing from the location to the target
-      float d = desired.mag();
+      fix16 d = desired.mag();
       // Normalize desired and scale with arbitrary damping within 100 pixels
       desired.normalize();
       if (d < 4) {
-        float m = map(d, 0, 100, 0, maxspeed);
+        fix16 m = d * maxspeed / 100;
         desired *= m;
       }
       else {
@@ -276,7 +265,7 @@ class Boid {
       if (location.y >= MATRIX_HEIGHT) location.y = MATRIX_HEIGHT - 1;
     }
 
-    bool bounceOffBorders(float bounce) {
+    bool bounceOffBorders(fix16 bounce) {
       bool bounced = false;
 
       if (location.x >= MATRIX_WIDTH) {
@@ -322,5 +311,4 @@ class Boid {
     }
 };
 
-static const uint8_t AVAILABLE_BOID_COUNT = 40;
 Boid boids[AVAILABLE_BOID_COUNT];
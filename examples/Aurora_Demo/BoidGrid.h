@@ -0,0 +1,105 @@
+/*
+ * Uniform grid over the panel indexing the boids by cell : the flocking rules only visit the boids
+ * of the cells within their neighbour distance instead of the whole flock.
+ * Each cell holds a doubly linked list of its boids, a boid crossing into another cell is moved
+ * from one list to the other, so the grid follows the flock without being rebuilt every frame.
+ */
+
+#ifndef BoidGrid_H
+#define BoidGrid_H
+
+// Flock sized to the panel, one boid per 16 pixels
+static const uint16_t AVAILABLE_BOID_COUNT = (MATRIX_WIDTH * MATRIX_HEIGHT / 16 > 40) ? MATRIX_WIDTH * MATRIX_HEIGHT / 16 : 40;
+
+// 8x8 pixels cells : the default neighbour distance
+#define BOID_GRID_SHIFT 3
+#define BOID_GRID_COLUMNS ((MATRIX_WIDTH + (1 << BOID_GRID_SHIFT) - 1) >> BOID_GRID_SHIFT)
+#define BOID_GRID_ROWS ((MATRIX_HEIGHT + (1 << BOID_GRID_SHIFT) - 1) >> BOID_GRID_SHIFT)
+#define BOID_NONE 0xFFFF
+
+class BoidGrid {
+  public:
+    BoidGrid() {
+      clear();
+    }
+
+    void clear() {
+      for (uint16_t i = 0; i < BOID_GRID_COLUMNS * BOID_GRID_ROWS; i++)
+        heads[i] = BOID_NONE;
+      for (uint16_t i = 0; i < AVAILABLE_BOID_COUNT; i++)
+        cells[i] = BOID_NONE;
+    }
+
+    // Adds the boid or moves it to the cell of its new location
+    void update(uint16_t index, PVector location) {
+      uint16_t cell = cellOf(location);
+      if (cell == cells[index])
+        return;
+      remove(index);
+      cells[index] = cell;
+      prevs[index] = BOID_NONE;
+      nexts[index] = heads[cell];
+      if (heads[cell] != BOID_NONE)
+        prevs[heads[cell]] = index;
+      heads[cell] = index;
+    }
+
+    void remove(uint16_t index) {
+      uint16_t cell = cells[index];
+      if (cell == BOID_NONE)
+        return;
+      if (prevs[index] != BOID_NONE)
+        nexts[prevs[index]] = nexts[index];
+      else
+        heads[cell] = nexts[index];
+      if (nexts[index] != BOID_NONE)
+        prevs[nexts[index]] = prevs[index];
+      cells[index] = BOID_NONE;
+    }
+
+    // Boids of a cell : first(), then next() until BOID_NONE
+    uint16_t first(uint8_t column, uint8_t row) {
+      return heads[row * BOID_GRID_COLUMNS + column];
+    }
+
+    uint16_t next(uint16_t index) {
+      return nexts[index];
+    }
+
+    // Cells covering the square of the radius around the location
+    void range(PVector location, fix16 radius, uint8_t &column0, uint8_t &row0, uint8_t &column1, uint8_t &row1) {
+      column0 = clampColumn((int)(location.x - radius));
+      column1 = clampColumn((int)(location.x + radius));
+      row0 = clampRow((int)(location.y - radius));
+      row1 = clampRow((int)(location.y + radius));
+    }
+
+  private:
+    uint16_t heads[BOID_GRID_COLUMNS * BOID_GRID_ROWS];
+    uint16_t cells[AVAILABLE_BOID_COUNT];
+    uint16_t nexts[AVAILABLE_BOID_COUNT];
+    uint16_t prevs[AVAILABLE_BOID_COUNT];
+
+    // Boids out of the panel are kept in the border cells
+    static uint8_t clampColumn(int x) {
+      if (x < 0)
+        return 0;
+      if (x >= MATRIX_WIDTH)
+        return BOID_GRID_COLUMNS - 1;
+      return x >> BOID_GRID_SHIFT;
+    }
+
+    static uint8_t clampRow(int y) {
+      if (y < 0)
+        return 0;
+      if (y >= MATRIX_HEIGHT)
+        return BOID_GRID_ROWS - 1;
+      return y >> BOID_GRID_SHIFT;
+    }
+
+    static uint16_t cellOf(PVector location) {
+      return clampRow((int)location.y) * BOID_GRID_COLUMNS + clampColumn((int)location.x);
+    }
+};
+
+#endif
@@ -43,6 +43,17 @@ public:
         return 0;
     };
 
+    // a heavy frame may be drawn in slices, one per call from loop(), so the loop keeps running in between:
+    // drawSlice(0) .. drawSlice(getSlices() - 1), the last slice completes the frame and returns the delay
+    // as drawFrame() does. By default the whole frame is a single slice
+    virtual uint8_t getSlices() {
+        return 1;
+    }
+
+    virtual unsigned int drawSlice(uint8_t slice) {
+        return drawFrame();
+    }
+
     virtual void printTesting()
     {
       Serial.println("Testing...");
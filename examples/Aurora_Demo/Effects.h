@@ -89,6 +89,7 @@ uint32_t noise_scale_y;
 
 uint8_t noise[MATRIX_WIDTH][MATRIX_HEIGHT];
 uint8_t noisesmoothing;
+NoiseField noiseField;
 
 class Effects {
 public:
@@ -731,22 +732,12 @@ public:
     noise_scale_y = 6000;
   }
 
+  // noise[i][j] sampled at (noise_x + noise_scale_x * (i - MATRIX_CENTRE_Y), noise_y + noise_scale_y * (j - MATRIX_CENTRE_Y), noise_z),
+  // the whole field at once : no hashing nor full evaluation per cell
   void FillNoise() {
-    for (uint8_t i = 0; i < MATRIX_WIDTH; i++) {
-      uint32_t ioffset = noise_scale_x * (i - MATRIX_CENTRE_Y);
-
-      for (uint8_t j = 0; j < MATRIX_HEIGHT; j++) {
-        uint32_t joffset = noise_scale_y * (j - MATRIX_CENTRE_Y);
-
-        byte data = inoise16(noise_x + ioffset, noise_y + joffset, noise_z) >> 8;
-
-        uint8_t olddata = noise[i][j];
-        uint8_t newdata = scale8(olddata, noisesmoothing) + scale8(data, 256 - noisesmoothing);
-        data = newdata;
-
-        noise[i][j] = data;
-      }
-    }
+    noiseField.fill(&noise[0][0], MATRIX_WIDTH, MATRIX_HEIGHT, MATRIX_HEIGHT, 1,
+                    noise_x - noise_scale_x * MATRIX_CENTRE_Y, noise_y - noise_scale_y * MATRIX_CENTRE_Y, noise_z,
+                    noise_scale_x, noise_scale_y, noisesmoothing);
   }
 
   // non leds2 memory version.
@@ -0,0 +1,75 @@
+/*
+ * Q16.16 fixed point scalar for the vector math of the boids : the ESP8266 has no FPU,
+ * every float operation is a library call. Constants written as float literals are
+ * converted at compile time, nothing converts back implicitly.
+ */
+
+#ifndef Fixed_H
+#define Fixed_H
+
+class fix16 {
+public:
+    int32_t raw;
+
+    constexpr fix16() : raw(0) {}
+    constexpr fix16(int v) : raw(v * 65536) {}
+    constexpr fix16(long v) : raw(v * 65536) {}
+    constexpr fix16(float v) : raw((int32_t)(v * 65536.0f)) {}
+    constexpr fix16(double v) : raw((int32_t)(v * 65536.0)) {}
+
+    static fix16 fromRaw(int32_t raw) {
+        fix16 f;
+        f.raw = raw;
+        return f;
+    }
+
+    explicit operator int() const { return raw >> 16; }
+    explicit operator int16_t() const { return raw >> 16; }
+    explicit operator float() const { return raw / 65536.0f; }
+
+    fix16 operator-() const { return fromRaw(-raw); }
+    fix16 operator+(fix16 f) const { return fromRaw(raw + f.raw); }
+    fix16 operator-(fix16 f) const { return fromRaw(raw - f.raw); }
+    fix16 operator*(fix16 f) const { return fromRaw(((int64_t)raw * f.raw) >> 16); }
+    fix16 operator/(fix16 f) const {
+        if (f.raw == 0)
+            return fromRaw(raw < 0 ? INT32_MIN : INT32_MAX);
+        return fromRaw((int64_t)raw * 65536 / f.raw);
+    }
+
+    fix16& operator+=(fix16 f) { raw += f.raw; return *this; }
+    fix16& operator-=(fix16 f) { raw -= f.raw; return *this; }
+    fix16& operator*=(fix16 f) { return *this = *this * f; }
+    fix16& operator/=(fix16 f) { return *this = *this / f; }
+
+    bool operator==(fix16 f) const { return raw == f.raw; }
+    bool operator!=(fix16 f) const { return raw != f.raw; }
+    bool operator<(fix16 f) const { return raw < f.raw; }
+    bool operator<=(fix16 f) const { return raw <= f.raw; }
+    bool operator>(fix16 f) const { return raw > f.raw; }
+    bool operator>=(fix16 f) const { return raw >= f.raw; }
+};
+
+// Bit by bit square root of raw << 16, 24 iterations
+inline fix16 sqrt(fix16 f) {
+    if (f.raw <= 0)
+        return fix16();
+    uint64_t value = (uint64_t)f.raw << 16;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 46;
+    while (bit > value)
+        bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return fix16::fromRaw((int32_t)root);
+}
+
+#endif
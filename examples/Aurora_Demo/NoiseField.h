@@ -0,0 +1,204 @@
+/*
+ * Fixed point 3D gradient noise filling a whole field at once, for the noise based patterns.
+ *
+ * Coordinates and scales are the ones of inoise16() (16.16 lattice units). The field is walked
+ * column by column : within one lattice cell the x and z interpolation weights are constant, so the
+ * noise along the column is the blend of two straight lines. Each cell costs one setup of its 8 corners,
+ * each pixel 3 multiplications, instead of a full evaluation with its hashing per pixel.
+ * The gradients of the lattice points are cached for the two z planes around z : advancing z within
+ * the same lattice cell, or moving x and y by less than a cell, reuses them.
+ */
+
+#ifndef NoiseField_H
+#define NoiseField_H
+
+#define NOISE_OCTAVES 3
+// Lattice points cached per octave and axis, 16 cells : scales down to 4 pixels per cell on 64 pixels
+#define NOISE_CACHE_SIZE 17
+
+class NoiseField {
+  public:
+    uint8_t octaves = 1;    // Each one twice the frequency and half the amplitude of the previous
+
+    NoiseField() {
+      // 6t^5 - 15t^4 + 10t^3, 16 bits
+      for (int32_t i = 0; i < 256; i++) {
+        int64_t t = i << 8;
+        int64_t t3 = (((t * t) >> 16) * t) >> 16;
+        int64_t inner = ((t * (6 * t - 15 * 65536)) >> 16) + 10 * 65536;
+        fade[i] = (t3 * inner) >> 16;
+      }
+      for (uint8_t o = 0; o < NOISE_OCTAVES; o++)
+        cacheValid[o] = false;
+    }
+
+    // Pixel (i, j) is written at out[i * columnStride + j * rowStride], sampled at (x + i * scaleX, y + j * scaleY, z).
+    // With smoothing the new value is blended into the previous one as scale8(old, smoothing) + scale8(new, 256 - smoothing).
+    void fill(uint8_t *out, uint8_t width, uint8_t height, int16_t columnStride, int16_t rowStride,
+              uint32_t x, uint32_t y, uint32_t z, uint32_t scaleX, uint32_t scaleY, uint8_t smoothing = 0) {
+      if (height > MATRIX_HEIGHT)
+        height = MATRIX_HEIGHT;
+      uint8_t count = octaves < 1 ? 1 : octaves > NOISE_OCTAVES ? NOISE_OCTAVES : octaves;
+
+      for (uint8_t o = 0; o < count; o++)
+        prepare(o, (x << o) + octaveOffset(o), (y << o) + octaveOffset(o), width, height, scaleX << o, scaleY << o);
+
+      for (uint8_t i = 0; i < width; i++) {
+        for (uint8_t o = 0; o < count; o++) {
+          uint32_t ox = (x << o) + octaveOffset(o) + i * (scaleX << o);
+          uint32_t oy = (y << o) + octaveOffset(o);
+          uint32_t oz = (z << o) + octaveOffset(o);
+          column(o, ox, oy, oz, scaleY << o, height, o == 0);
+        }
+
+        uint8_t *pixel = out + i * columnStride;
+        for (uint8_t j = 0; j < height; j++, pixel += rowStride) {
+          // Octaves summed as n0 * 4 + n1 * 2 + n2 : total amplitude brought back to the one of a single octave
+          int32_t n = sums[j];
+          if (count > 1)
+            n /= (1 << count) - 1;
+          n = 128 + ((n * 181) >> 12);
+          uint8_t data = n < 0 ? 0 : n > 255 ? 255 : n;
+          if (smoothing)
+            data = scale8(*pixel, smoothing) + scale8(data, 256 - smoothing);
+          *pixel = data;
+        }
+      }
+    }
+
+  private:
+    uint16_t fade[256];
+    int32_t sums[MATRIX_HEIGHT];
+
+    // Gradients of the two z planes of the lattice points, 4 bits each, from (cacheX, cacheY)
+    uint8_t cache[NOISE_OCTAVES][NOISE_CACHE_SIZE * NOISE_CACHE_SIZE];
+    bool cacheValid[NOISE_OCTAVES];
+    bool cacheUsed[NOISE_OCTAVES];
+    uint8_t cacheX[NOISE_OCTAVES];
+    uint8_t cacheY[NOISE_OCTAVES];
+    uint8_t cacheZ[NOISE_OCTAVES];
+
+    // Octaves sampled away from each other, not on a lattice point of the previous one
+    static uint32_t octaveOffset(uint8_t o) {
+      return o * 0x3B9AC5F1;
+    }
+
+    static uint8_t hash(uint8_t x, uint8_t y, uint8_t z) {
+      return permutation[(uint8_t)(permutation[(uint8_t)(permutation[x] + y)] + z)];
+    }
+
+    uint8_t gradients(uint8_t o, uint8_t x, uint8_t y, uint8_t z) {
+      if (cacheUsed[o])
+        return cache[o][(uint8_t)(x - cacheX[o]) * NOISE_CACHE_SIZE + (uint8_t)(y - cacheY[o])];
+      return (hash(x, y, z) & 15) | (hash(x, y, z + 1) << 4);
+    }
+
+    // The cache follows the lattice points of the field, unless they do not fit
+    void prepare(uint8_t o, uint32_t x, uint32_t y, uint8_t width, uint8_t height, uint32_t scaleX, uint32_t scaleY) {
+      uint32_t spanX = ((x & 0xFFFF) + (width - 1) * scaleX) >> 16;
+      uint32_t spanY = ((y & 0xFFFF) + (height - 1) * scaleY) >> 16;
+      cacheUsed[o] = (spanX + 2 <= NOISE_CACHE_SIZE) && (spanY + 2 <= NOISE_CACHE_SIZE);
+      if (((uint8_t)(x >> 16) != cacheX[o]) || ((uint8_t)(y >> 16) != cacheY[o]))
+        cacheValid[o] = false;
+      cacheX[o] = x >> 16;
+      cacheY[o] = y >> 16;
+    }
+
+    // Rebuilt when the field moved by a cell or z entered another cell
+    void refresh(uint8_t o, uint8_t z) {
+      if (cacheValid[o] && (cacheZ[o] == z))
+        return;
+      for (uint8_t i = 0; i < NOISE_CACHE_SIZE; i++)
+        for (uint8_t j = 0; j < NOISE_CACHE_SIZE; j++) {
+          uint8_t h = permutation[(uint8_t)(permutation[(uint8_t)(cacheX[o] + i)] + (uint8_t)(cacheY[o] + j))];
+          cache[o][i * NOISE_CACHE_SIZE + j] = (permutation[(uint8_t)(h + z)] & 15) | (permutation[(uint8_t)(h + z + 1)] << 4);
+        }
+      cacheZ[o] = z;
+      cacheValid[o] = true;
+    }
+
+    // Noise of one column of one octave (12 bits fractions), written or added to sums
+    void column(uint8_t o, uint32_t x, uint32_t y, uint32_t z, uint32_t scaleY, uint8_t height, bool first) {
+      uint8_t cx = x >> 16;
+      uint8_t cz = z >> 16;
+      int32_t fx = (x & 0xFFFF) >> 4;
+      int32_t fz = (z & 0xFFFF) >> 4;
+      int32_t u = fade[fx >> 4];
+      int32_t w = fade[fz >> 4];
+      if (cacheUsed[o])
+        refresh(o, cz);
+
+      int32_t a0 = 0, b0 = 0, a1 = 0, b1 = 0;
+      uint16_t cellY = 0;
+      uint32_t yj = y;
+      for (uint8_t j = 0; j < height; j++, yj += scaleY) {
+        int32_t fy = (yj & 0xFFFF) >> 4;
+        if ((j == 0) || ((yj >> 16) != cellY)) {
+          cellY = yj >> 16;
+          uint8_t cy = cellY;
+          // Corner (dx, dy, dz) : gx * (fx - dx) + gy * (fy - dy) + gz * (fz - dz), linear in fy along the column
+          uint8_t g00 = gradients(o, cx, cy, cz);
+          uint8_t g10 = gradients(o, cx + 1, cy, cz);
+          uint8_t g01 = gradients(o, cx, cy + 1, cz);
+          uint8_t g11 = gradients(o, cx + 1, cy + 1, cz);
+          lineOf(g00, g10, fx, fz, u, w, 0, a0, b0);
+          lineOf(g01, g11, fx, fz, u, w, 4096, a1, b1);
+        }
+        int32_t n0 = a0 + ((b0 * fy) >> 12);
+        int32_t n1 = a1 + ((b1 * fy) >> 12);
+        int32_t n = n0 + (((n1 - n0) * (int32_t)fade[fy >> 4]) >> 16);
+        if (first)
+          sums[j] = n;
+        else
+          sums[j] = sums[j] * 2 + n;
+      }
+    }
+
+    // Blend over x and z of the 4 corners of one y side of the cell : a + b * fy
+    static void lineOf(uint8_t gx0, uint8_t gx1, int32_t fx, int32_t fz, int32_t u, int32_t w, int32_t dy, int32_t &a, int32_t &b) {
+      // Low nibble plane z, high nibble plane z + 1
+      int32_t k000 = constant(gx0 & 15, fx, fz, dy);
+      int32_t k100 = constant(gx1 & 15, fx - 4096, fz, dy);
+      int32_t k001 = constant(gx0 >> 4, fx, fz - 4096, dy);
+      int32_t k101 = constant(gx1 >> 4, fx - 4096, fz - 4096, dy);
+      int32_t kz0 = k000 + (((k100 - k000) * u) >> 16);
+      int32_t kz1 = k001 + (((k101 - k001) * u) >> 16);
+      a = kz0 + (((kz1 - kz0) * w) >> 16);
+      int32_t s000 = gradY[gx0 & 15] * 4096;
+      int32_t s100 = gradY[gx1 & 15] * 4096;
+      int32_t s001 = gradY[gx0 >> 4] * 4096;
+      int32_t s101 = gradY[gx1 >> 4] * 4096;
+      int32_t sz0 = s000 + (((s100 - s000) * u) >> 16);
+      int32_t sz1 = s001 + (((s101 - s001) * u) >> 16);
+      b = sz0 + (((sz1 - sz0) * w) >> 16);
+    }
+
+    static int32_t constant(uint8_t g, int32_t dx, int32_t dz, int32_t dy) {
+      return gradX[g] * dx + gradZ[g] * dz - gradY[g] * dy;
+    }
+
+    // Improved noise gradients : the 12 cube edges, 4 of them twice
+    static const int8_t gradX[16];
+    static const int8_t gradY[16];
+    static const int8_t gradZ[16];
+    static const uint8_t permutation[256];
+};
+
+const int8_t NoiseField::gradX[16] = {1, -1, 1, -1, 1, -1, 1, -1, 0, 0, 0, 0, 1, -1, 0, 0};
+const int8_t NoiseField::gradY[16] = {1, 1, -1, -1, 0, 0, 0, 0, 1, -1, 1, -1, 1, 1, -1, -1};
+const int8_t NoiseField::gradZ[16] = {0, 0, 0, 0, 1, 1, -1, -1, 1, 1, -1, -1, 0, 0, 1, -1};
+
+const uint8_t NoiseField::permutation[256] = {
+  151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225, 140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23,
+  190, 6, 148, 247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32, 57, 177, 33, 88, 237, 149, 56, 87, 174, 20,
+  125, 136, 171, 168, 68, 175, 74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122, 60, 211, 133, 230, 220,
+  105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54, 65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169, 200,
+  196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64, 52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118,
+  126, 255, 82, 85, 212, 207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213, 119, 248, 152, 2, 44, 154,
+  163, 70, 221, 153, 101, 155, 167, 43, 172, 9, 129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104, 218,
+  246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241, 81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31,
+  181, 199, 106, 157, 184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93, 114, 67, 29, 24, 72, 243, 141,
+  128, 195, 78, 66, 215, 61, 156, 180
+};
+
+#endif
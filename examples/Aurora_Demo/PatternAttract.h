@@ -40,7 +40,7 @@ public:
         for (int i = 0; i < count; i++) {
             Boid boid = Boid(15, 31 - i);
             boid.mass = 1; // random(0.1, 2);
-            boid.velocity.x = ((float) random(40, 50)) / 100.0;
+            boid.velocity.x = fix16(random(40, 50)) / 100;
             boid.velocity.x *= direction;
             boid.velocity.y = 0;
             boid.colorIndex = i * 32;
@@ -61,7 +61,7 @@ public:
             boid.applyForce(force);
 
             boid.update();
-            effects.drawBackgroundFastLEDPixelCRGB(boid.location.x, boid.location.y, effects.ColorFromCurrentPalette(boid.colorIndex));
+            effects.drawBackgroundFastLEDPixelCRGB((int16_t)boid.location.x, (int16_t)boid.location.y, effects.ColorFromCurrentPalette(boid.colorIndex));
 
             boids[i] = boid;
         }
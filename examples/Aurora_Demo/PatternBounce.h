@@ -37,7 +37,7 @@ public:
         for (int i = 0; i < count; i++) {
             Boid boid = Boid(i, 0);
             boid.velocity.x = 0;
-            boid.velocity.y = i * -0.01;
+            boid.velocity.y = fix16(-0.01) * i;
             boid.colorIndex = colorWidth * i;
             boid.maxforce = 10;
             boid.maxspeed = 10;
@@ -56,7 +56,7 @@ public:
 
             boid.update();
 
-            effects.drawBackgroundFastLEDPixelCRGB(boid.location.x, boid.location.y, effects.ColorFromCurrentPalette(boid.colorIndex));
+            effects.drawBackgroundFastLEDPixelCRGB((int16_t)boid.location.x, (int16_t)boid.location.y, effects.ColorFromCurrentPalette(boid.colorIndex));
 
             if (boid.location.y >= MATRIX_HEIGHT - 1) {
                 boid.location.y = MATRIX_HEIGHT - 1;
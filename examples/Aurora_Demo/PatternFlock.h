@@ -41,18 +41,22 @@ class PatternFlock : public Drawable {
       name = (char *)"Flock";
     }
 
-    static const int boidCount = 10;
+    // Hundreds on a 64x64 panel : the neighbours come from the grid, not from the whole flock
+    static const int boidCount = AVAILABLE_BOID_COUNT;
     Boid predator;
+    BoidGrid grid;
 
     PVector wind;
     byte hue = 0;
     bool predatorPresent = true;
 
     void start() {
+      grid.clear();
       for (int i = 0; i < boidCount; i++) {
-        boids[i] = Boid(15, 15);
+        boids[i] = Boid(random(MATRIX_WIDTH), random(MATRIX_HEIGHT));
         boids[i].maxspeed = 0.380;
         boids[i].maxforce = 0.015;
+        grid.update(i, boids[i].location);
       }
 
       predatorPresent = random(0, 2) >= 1;
@@ -85,13 +89,14 @@ class PatternFlock : public Drawable {
           boid->repelForce(predator.location, 10);
         }
 
-        boid->run(boids, boidCount);
+        boid->run(boids, grid);
         boid->wrapAroundBorders();
+        grid.update(i, boid->location);
         PVector location = boid->location;
         // PVector velocity = boid->velocity;
         // backgroundLayer.drawLine(location.x, location.y, location.x - velocity.x, location.y - velocity.y, color);
         // effects.leds[XY(location.x, location.y)] += color;
-        effects.drawBackgroundFastLEDPixelCRGB(location.x, location.y, color);
+        effects.drawBackgroundFastLEDPixelCRGB((int16_t)location.x, (int16_t)location.y, color);
 
         if (applyWind) {
           boid->applyForce(wind);
@@ -100,14 +105,14 @@ class PatternFlock : public Drawable {
       }
 
       if (predatorPresent) {
-        predator.run(boids, boidCount);
+        predator.run(boids, grid);
         predator.wrapAroundBorders();
         color = effects.ColorFromCurrentPalette(hue + 128);
         PVector location = predator.location;
         // PVector velocity = predator.velocity;
         // backgroundLayer.drawLine(location.x, location.y, location.x - velocity.x, location.y - velocity.y, color);
         // effects.leds[XY(location.x, location.y)] += color;        
-        effects.drawBackgroundFastLEDPixelCRGB(location.x, location.y, color);
+        effects.drawBackgroundFastLEDPixelCRGB((int16_t)location.x, (int16_t)location.y, color);
       }
 
       EVERY_N_MILLIS(200) {
@@ -57,16 +57,16 @@ class PatternFlowField : public Drawable {
       for (int i = 0; i < count; i++) {
         Boid * boid = &boids[i];
 
-        int ioffset = scale * boid->location.x;
-        int joffset = scale * boid->location.y;
+        int ioffset = (int)(boid->location.x * scale);
+        int joffset = (int)(boid->location.y * scale);
 
         byte angle = inoise8(x + ioffset, y + joffset, z);
 
-        boid->velocity.x = (float) sin8(angle) * 0.0078125 - 1.0;
-        boid->velocity.y = -((float)cos8(angle) * 0.0078125 - 1.0);
+        boid->velocity.x = fix16(sin8(angle)) * 0.0078125 - 1;
+        boid->velocity.y = -(fix16(cos8(angle)) * 0.0078125 - 1);
         boid->update();
 
-        effects.drawBackgroundFastLEDPixelCRGB(boid->location.x, boid->location.y, effects.ColorFromCurrentPalette(angle + hue)); // color
+        effects.drawBackgroundFastLEDPixelCRGB((int16_t)boid->location.x, (int16_t)boid->location.y, effects.ColorFromCurrentPalette(angle + hue)); // color
 
         if (boid->location.x < 0 || boid->location.x >= MATRIX_WIDTH ||
             boid->location.y < 0 || boid->location.y >= MATRIX_HEIGHT) {
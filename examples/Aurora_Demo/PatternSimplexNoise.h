@@ -40,18 +40,32 @@ class PatternSimplexNoise : public Drawable {
     }
 
     unsigned int drawFrame() {
+      drawSlice(0);
+      return drawSlice(1);
+    }
+
+    // the noise field is filled in a first slice, mapped to the palette and shown in a second one
+    uint8_t getSlices() {
+      return 2;
+    }
+
+    unsigned int drawSlice(uint8_t slice) {
+      if (slice == 0) {
 #if FASTLED_VERSION >= 3001000
-      // a new parameter set every 15 seconds
-      EVERY_N_SECONDS(15) {
-        noise_x = random16();
-        noise_y = random16();
-        noise_z = random16();
-      }
+        // a new parameter set every 15 seconds
+        EVERY_N_SECONDS(15) {
+          noise_x = random16();
+          noise_y = random16();
+          noise_z = random16();
+        }
 #endif
 
+        effects.FillNoise();
+        return 0;
+      }
+
       uint32_t speed = 100;
 
-      effects.FillNoise();
       ShowNoiseLayer(0, 1, 0);
 
       // noise_x += speed;
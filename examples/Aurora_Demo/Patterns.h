@@ -26,6 +26,7 @@
 #define ARRAY_SIZE(A) (sizeof(A) / sizeof((A)[0]))
 
 #include "Vector.h"
+#include "BoidGrid.h"
 #include "Boid.h"
 #include "Attractor.h"
 
@@ -66,6 +67,8 @@
 #include "PatternSpiral.h"
 
 class Patterns : public Playlist {
+  friend class Scheduler;
+
   private:
     PatternTest patternTest;
  //   PatternRainbowFlag rainbowFlag; // doesn't work
@@ -234,6 +237,14 @@ class Patterns : public Playlist {
       return currentItem->drawFrame();
     }
 
+    uint8_t getSlices() {
+      return currentItem->getSlices();
+    }
+
+    unsigned int drawSlice(uint8_t slice) {
+      return currentItem->drawSlice(slice);
+    }
+
     void listPatterns() {
       Serial.println(F("{"));
       Serial.print(F("  \"count\": "));
@@ -0,0 +1,135 @@
+/*
+ * Frame scheduler for the patterns : loop() calls run() as often as it can, the scheduler draws one slice
+ * of the current frame per call (see Drawable::drawSlice()) so the loop is never held for a whole heavy
+ * frame, and shows the frame only once its last slice is drawn.
+ * Each pattern's drawing time is measured with the CPU cycle counter, a pattern costing more than its
+ * share of the CPU gets a longer frame interval than the one it requests, and pattern changes wait for
+ * the current frame to be complete.
+ */
+
+#ifndef Scheduler_H
+#define Scheduler_H
+
+// Share of the CPU the patterns may use, the rest is left to loop() and the display refresh
+#ifndef SCHEDULER_LOAD
+#define SCHEDULER_LOAD 70
+#endif
+
+class Scheduler {
+  public:
+    struct PatternCost {
+      uint32_t frames;          // Frames drawn
+      uint32_t throttled;       // Frames delayed beyond the requested interval
+      uint32_t averageUs;       // Moving average of the frame drawing time (1/8 weight)
+      uint32_t maxUs;           // Slowest frame
+      uint32_t maxSliceUs;      // Slowest slice : the longest loop() is held
+      uint16_t intervalMs;      // Current interval between frames
+    };
+
+    Scheduler(Patterns &patterns) : patterns(patterns) {
+      resetCosts();
+    }
+
+    void setLoad(uint8_t percent) {
+      load = percent ? percent : 1;
+    }
+
+    // Pattern changes are applied when the current frame is complete
+    void move(int step) {
+      pendingStep = step;
+      pending = true;
+    }
+
+    // Call from loop() : draws the next slice when due, true when a frame is complete and should be shown
+    bool run() {
+      unsigned long now = millis();
+      if (slice == 0) {
+        if (pending) {
+          applyMove();
+          now = millis();
+          nextFrame = now;
+        }
+        if ((long)(now - nextFrame) < 0)
+          return false;
+        frameStart = now;
+        frameCycles = 0;
+      }
+
+      PatternCost &cost = costs[patterns.currentIndex];
+      uint32_t start = ESP.getCycleCount();
+      unsigned int requested = patterns.drawSlice(slice);
+      uint32_t cycles = ESP.getCycleCount() - start;
+      uint32_t sliceUs = cycles / ESP.getCpuFreqMHz();
+      if (sliceUs > cost.maxSliceUs)
+        cost.maxSliceUs = sliceUs;
+      frameCycles += cycles;
+
+      if (++slice < patterns.getSlices())
+        return false;
+      slice = 0;
+
+      uint32_t us = frameCycles / ESP.getCpuFreqMHz();
+      cost.frames++;
+      if (us > cost.maxUs)
+        cost.maxUs = us;
+      if (cost.frames == 1)
+        cost.averageUs = us;
+      else
+        cost.averageUs = (cost.averageUs * 7 + us) / 8;
+
+      // The frame may take load % of its interval
+      uint32_t interval = cost.averageUs * 100 / load / 1000;
+      if (interval > requested)
+        cost.throttled++;
+      else
+        interval = requested;
+      if (interval > 0xFFFF)
+        interval = 0xFFFF;
+      cost.intervalMs = interval;
+      nextFrame = frameStart + interval;
+      return true;
+    }
+
+    void getCost(int index, PatternCost &cost) {
+      cost = costs[index];
+    }
+
+    void resetCosts() {
+      memset(costs, 0, sizeof(costs));
+    }
+
+    void printCosts() {
+      Serial.println(F("pattern           frames  avg us  max us  slice us  interval ms  throttled"));
+      for (int i = 0; i < Patterns::PATTERN_COUNT; i++) {
+        PatternCost &cost = costs[i];
+        if (cost.frames == 0)
+          continue;
+        Serial.printf("%-16s %7u %7u %7u %9u %12u %10u\n", patterns.items[i]->name, (unsigned)cost.frames,
+          (unsigned)cost.averageUs, (unsigned)cost.maxUs, (unsigned)cost.maxSliceUs, (unsigned)cost.intervalMs,
+          (unsigned)cost.throttled);
+      }
+    }
+
+  private:
+    void applyMove() {
+      pending = false;
+      patterns.stop();
+      patterns.move(pendingStep);
+      patterns.start();
+
+      Serial.print("Changing pattern to:  ");
+      Serial.println(patterns.getCurrentPatternName());
+    }
+
+    Patterns &patterns;
+    PatternCost costs[Patterns::PATTERN_COUNT];
+    uint8_t load = SCHEDULER_LOAD;
+    uint8_t slice = 0;
+    bool pending = false;
+    int pendingStep = 0;
+    unsigned long frameStart = 0;
+    unsigned long nextFrame = 0;
+    uint32_t frameCycles = 0;
+};
+
+#endif
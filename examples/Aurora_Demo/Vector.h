@@ -23,6 +23,8 @@
 #ifndef Vector_H
 #define Vector_H
 
+#include "Fixed.h"
+
 template <class T>
 class Vector2 {
 public:
@@ -68,35 +70,35 @@ public:
         return *this;
     }
 
-    Vector2 operator+(double s) {
+    Vector2 operator+(T s) {
         return Vector2(x + s, y + s);
     }
-    Vector2 operator-(double s) {
+    Vector2 operator-(T s) {
         return Vector2(x - s, y - s);
     }
-    Vector2 operator*(double s) {
+    Vector2 operator*(T s) {
         return Vector2(x * s, y * s);
     }
-    Vector2 operator/(double s) {
+    Vector2 operator/(T s) {
         return Vector2(x / s, y / s);
     }
     
-    Vector2& operator+=(double s) {
+    Vector2& operator+=(T s) {
         x += s;
         y += s;
         return *this;
     }
-    Vector2& operator-=(double s) {
+    Vector2& operator-=(T s) {
         x -= s;
         y -= s;
         return *this;
     }
-    Vector2& operator*=(double s) {
+    Vector2& operator*=(T s) {
         x *= s;
         y *= s;
         return *this;
     }
-    Vector2& operator/=(double s) {
+    Vector2& operator/=(T s) {
         x /= s;
         y /= s;
         return *this;
@@ -118,24 +120,25 @@ public:
     }
 
     Vector2& normalize() {
-        if (length() == 0) return *this;
-        *this *= (1.0 / length());
+        T l = length();
+        if (l == 0) return *this;
+        *this /= l;
         return *this;
     }
 
-    float dist(Vector2 v) const {
+    T dist(Vector2 v) const {
         Vector2 d(v.x - x, v.y - y);
         return d.length();
     }
-    float length() const {
+    T length() const {
         return sqrt(x * x + y * y);
     }
 
-    float mag() const {
+    T mag() const {
         return length();
     }
 
-    float magSq() {
+    T magSq() {
         return (x * x + y * y);
     }
 
@@ -149,14 +152,14 @@ public:
         return Vector2(y, -x);
     }
 
-    static float dot(Vector2 v1, Vector2 v2) {
+    static T dot(Vector2 v1, Vector2 v2) {
         return v1.x * v2.x + v1.y * v2.y;
     }
-    static float cross(Vector2 v1, Vector2 v2) {
+    static T cross(Vector2 v1, Vector2 v2) {
         return (v1.x * v2.y) - (v1.y * v2.x);
     }
 
-    void limit(float max) {
+    void limit(T max) {
         if (magSq() > max*max) {
             normalize();
             *this *= max;
@@ -164,6 +167,7 @@ public:
     }
 };
 
-typedef Vector2<float> PVector;
+// Fixed point : boids math without float
+typedef Vector2<fix16> PVector;
 
 #endif
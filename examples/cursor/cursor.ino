@@ -0,0 +1,46 @@
+// Blinking cursor over unchanged content : the cursor mask is XORed into the bitplanes,
+// the same XOR removes it. Nothing is redrawn.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixDraw.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+// 7x7 arrow, drawBitmap() format
+static const uint8_t arrow[] PROGMEM = {
+  0b10000000,
+  0b11000000,
+  0b11100000,
+  0b11110000,
+  0b11111000,
+  0b11100000,
+  0b10100000,
+};
+
+RGBMatrixDraw display(64, 32);
+int16_t cursorX = 4;
+int16_t cursorY = 4;
+
+void setup() {
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 4, false);
+  RGBMatrix.enable();
+
+  display.fillRect(0, 0, 32, 32, display.color565(0, 0, 128));
+  display.fillRect(32, 0, 32, 32, display.color565(128, 64, 0));
+  display.setCursor(2, 12);
+  display.print("XOR me");
+}
+
+void loop() {
+  // Shown, then removed : the content under it is back as it was
+  RGBMatrix.rasterMask(cursorX, cursorY, 7, 7, arrow, ROP_XOR, 255, 255, 255);
+  delay(400);
+  RGBMatrix.rasterMask(cursorX, cursorY, 7, 7, arrow, ROP_XOR, 255, 255, 255);
+  delay(100);
+  cursorX = (cursorX + 3) % 60;
+}
@@ -0,0 +1,46 @@
+// Shows the frames sent over WiFi with DDP (xLights, WLED, extras/tools/ddp_send ...) :
+//   ./ddp_send -H <ip of the board> -w 64 -h 32 -t 40 anim.rgb
+// Pixels are RGB 8 bits, row major from the top left one, a frame is shown by its PUSH packet.
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixDDP.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+const char* ssid = "...";
+const char* password = "...";
+
+WiFiUDP udp;
+RGBMatrixDDP ddp;
+uint32_t lastReport = 0;
+
+void setup() {
+  Serial.begin(115200);
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(ssid, password);
+  while (WiFi.status() != WL_CONNECTED)
+    delay(100);
+  Serial.println(WiFi.localIP());
+
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 6, true);
+  RGBMatrix.enable();
+  ddp.begin(udp);
+}
+
+void loop() {
+  ddp.update();
+  if (millis() - lastReport > 5000) {
+    RGBMatrixDDP::ddpStats stats;
+    ddp.getStats(stats);
+    Serial.printf("frames %u, packets %u, dropped %u, late %u, incomplete %u, invalid %u\n",
+                  stats.frames, stats.packets, stats.dropped, stats.late, stats.incomplete, stats.invalid);
+    lastReport = millis();
+  }
+}
@@ -0,0 +1,30 @@
+// Plays a pre-encoded animation : frames are stored in the driver bitplane layout
+// and copied from flash to the frame buffer, no per pixel work at runtime.
+//
+// gradient_encoded.h was generated with extras/tools/rgbmatrix_asset :
+//   ./rgbmatrix_asset -w 32 -h 16 -d 4 -m 3 -t 250 -n gradient gradient.rgb > gradient_encoded.h
+// The options must match the setup below.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixAsset.h>
+#include "gradient_encoded.h"
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_OE 2
+
+RGBMatrixAsset animation;
+
+void setup() {
+  Serial.begin(115200);
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C);
+  RGBMatrix.begin(32, 16, 4, true);
+  RGBMatrix.enable();
+  if (!animation.begin(gradient))
+    Serial.println("Asset encoded for another layout");
+}
+
+void loop() {
+  animation.update();
+}
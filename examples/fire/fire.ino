@@ -0,0 +1,37 @@
+// Fire2012 over the whole panel : the heat is simulated 4 cells per word and used as the palette
+// indexes of an indexed frame, encoded into the bitplanes 8 pixels at a time.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixIndexed.h>
+#include <RGBMatrixFire.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+RGBMatrixIndexed frame;
+RGBMatrixFire fire;
+
+void setup() {
+  Serial.begin(115200);
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 5, true);
+  RGBMatrix.enable();
+  frame.begin();
+  RGBMatrixFire::loadHeatPalette(frame);
+  fire.begin(64, 32);
+  fire.seed(ESP.getCycleCount());
+  fire.setCooling(70);
+}
+
+void loop() {
+  uint32_t start = micros();
+  fire.step();
+  fire.draw(frame);
+  frame.update();
+  RGBMatrix.showBuffer();
+  Serial.printf("%u us\n", micros() - start);
+  delay(15);
+}
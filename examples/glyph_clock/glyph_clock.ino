@@ -0,0 +1,41 @@
+// Clock drawn every frame through the glyph cache : each digit is rasterized by Adafruit GFX once,
+// then blitted from its bitplane masks.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixGlyphCache.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+// Digits, colon and space at size 2 : 12 glyphs of 3 * 13 * 16 = 624 bytes
+RGBMatrixGlyphCache glyphs(8 * 1024, 12);
+
+void setup() {
+  Serial.begin(115200);
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 4, true);
+  RGBMatrix.enable();
+  glyphs.setTextSize(2);
+}
+
+void loop() {
+  uint32_t seconds = millis() / 1000;
+  char text[6];
+  snprintf(text, sizeof(text), "%02u%c%02u", (unsigned)(seconds / 60 % 60), (seconds & 1) ? ':' : ' ', (unsigned)(seconds % 60));
+
+  RGBMatrix.clearDisplay();
+  glyphs.drawText(3, 8, text, 0xFFE0);
+  RGBMatrix.showBuffer();
+
+  static uint32_t lastStats = 0;
+  if (millis() - lastStats > 10000) {
+    lastStats = millis();
+    RGBMatrixGlyphCache::glyphStats stats;
+    glyphs.getStats(stats);
+    Serial.printf("glyphs %u (%u bytes), hits %u, misses %u, evictions %u\n", stats.glyphs, stats.memory, stats.hits, stats.misses, stats.evictions);
+  }
+  delay(20);
+}
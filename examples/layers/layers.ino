@@ -0,0 +1,73 @@
+// Static background, scrolling text and a status overlay merged by a compositor : each frame only the
+// text area and the overlay when it changes are encoded again, the background costs nothing.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixLayer.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+// Background : 1 byte per pixel in a 16 colors palette
+RGBMatrixLayer background(LAYER_INDEXED, 64, 32);
+// Text : 1 bit per pixel, moved instead of redrawn
+RGBMatrixLayer text(LAYER_MASK, 168, 8);
+// Status : RGB565, black is transparent
+RGBMatrixLayer status(LAYER_RGB565, 64, 6);
+RGBMatrixCompositor compositor;
+
+uint8_t palette[16 * 3];
+int16_t textX = 64;
+
+void setup() {
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 4, true);
+  RGBMatrix.enable();
+
+  for (uint8_t i = 0; i < 16; i++) {
+    palette[3 * i] = 4 * i;
+    palette[3 * i + 1] = 0;
+    palette[3 * i + 2] = 64 - 4 * i;
+  }
+  background.begin();
+  background.setPalette(palette);
+  for (int16_t y = 0; y < 32; y++)
+    background.drawFastHLine(0, y, 64, y / 2);
+
+  text.begin();
+  text.setColor(255, 200, 0);
+  text.setTextColor(1);
+  text.setTextWrap(false);
+  text.setCursor(0, 0);
+  text.print("Layers merged at encode time");
+  text.setPosition(textX, 12);
+  text.setZ(1);
+
+  status.begin();
+  status.setTransparent(0);
+  status.setZ(2);
+
+  compositor.add(background);
+  compositor.add(text);
+  compositor.add(status);
+}
+
+void loop() {
+  text.setPosition(textX, 12);
+  if (--textX < -(int16_t)text.width())
+    textX = 64;
+
+  // Overlay redrawn once a second
+  static uint32_t lastSecond = 0;
+  if (millis() / 1000 != lastSecond) {
+    lastSecond = millis() / 1000;
+    status.fillScreen(0);
+    status.fillRect(0, 0, lastSecond % 64, 2, 0x07E0);
+  }
+
+  compositor.update();
+  RGBMatrix.showBuffer();
+  delay(30);
+}
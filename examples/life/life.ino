@@ -0,0 +1,41 @@
+// Game of Life on the whole panel : a generation is computed 32 cells at a time on a bit packed grid,
+// the live cells are drawn over the previous frames faded by dim(), leaving trails.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixLife.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+RGBMatrixLife life;
+uint8_t hue = 0;
+
+void setup() {
+  Serial.begin(115200);
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 5, false);
+  RGBMatrix.enable();
+  life.begin(64, 32);
+  life.randomize(80);
+}
+
+void loop() {
+  uint32_t start = micros();
+  uint32_t population = life.step();
+  RGBMatrix.dim(192);
+  // Color walking around the wheel with the generations
+  uint8_t r = hue < 85 ? 255 - hue * 3 : hue < 170 ? 0 : (hue - 170) * 3;
+  uint8_t g = hue < 85 ? hue * 3 : hue < 170 ? 255 - (hue - 85) * 3 : 0;
+  uint8_t b = hue < 85 ? 0 : hue < 170 ? (hue - 85) * 3 : 255 - (hue - 170) * 3;
+  life.draw(0, 0, r, g, b);
+  hue++;
+  Serial.printf("generation %u : %u cells, %u us\n", life.getGeneration(), population, micros() - start);
+
+  // Reseeded when dead or stuck
+  if ((population < 20) || (life.getGeneration() > 1000))
+    life.randomize(80);
+  delay(60);
+}
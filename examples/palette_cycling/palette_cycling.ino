@@ -0,0 +1,44 @@
+// Plasma drawn once as palette indexes, then animated by palette cycling only : each frame is one
+// bulk encoding pass, the indexes are never redrawn.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixIndexed.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+RGBMatrixIndexed frame;
+
+void setup() {
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 5, true);
+  RGBMatrix.enable();
+  frame.begin();
+
+  // Rainbow palette
+  for (uint16_t i = 0; i < 256; i++) {
+    uint8_t phase = i % 85 * 3;
+    if (i < 85)
+      frame.setColor(i, 255 - phase, phase, 0);
+    else if (i < 170)
+      frame.setColor(i, 0, 255 - phase, phase);
+    else
+      frame.setColor(i, phase, 0, 255 - phase);
+  }
+
+  for (int16_t y = 0; y < 32; y++)
+    for (int16_t x = 0; x < 64; x++) {
+      float v = sin(x / 8.0) + sin(y / 5.0) + sin((x + y) / 11.0) + sin(sqrt(x * x + y * y) / 6.0);
+      frame.setPixel(x, y, (uint8_t)((v + 4) * 32));
+    }
+}
+
+void loop() {
+  frame.setPaletteOffset(frame.getPaletteOffset() + 2);
+  frame.update();
+  RGBMatrix.showBuffer();
+  delay(20);
+}
@@ -0,0 +1,29 @@
+// Shows the frames pushed over USB serial by extras/tools/serial_send :
+//   ./serial_send -p /dev/ttyUSB0 -b 921600 -w 64 -h 32 -R anim.rgb
+//   ./serial_send -p /dev/ttyUSB0 -b 921600 -w 64 -h 32 -d 6 -M planes anim.rgb
+// For planes the layout options must be the ones below. Nothing else may print on Serial.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixSerial.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+RGBMatrixSerial frames;
+
+void setup() {
+  // The whole window must fit in the RX buffer
+  Serial.setRxBufferSize(RGBMATRIX_SERIAL_WINDOW * (RGBMATRIX_SERIAL_HEADER + RGBMATRIX_SERIAL_PAYLOAD + RGBMATRIX_SERIAL_CRC));
+  Serial.begin(921600);
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 6, true);
+  RGBMatrix.enable();
+  frames.begin(Serial);
+}
+
+void loop() {
+  frames.update();
+}
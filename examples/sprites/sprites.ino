@@ -0,0 +1,53 @@
+// Invaders marching over a background : the sprites are encoded once into bit rows by begin()
+// and draw() merges them 8 pixels at a time into the bitplanes.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixSprite.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+#define INVADER_W 11
+#define INVADER_H 8
+
+// drawBitmap() format : 1 bit per pixel, MSB first, rows padded to a byte
+static const uint8_t invaderMask[] PROGMEM = {
+  0b00100000, 0b10000000,
+  0b00010001, 0b00000000,
+  0b00111111, 0b10000000,
+  0b01101110, 0b11000000,
+  0b11111111, 0b11100000,
+  0b10111111, 0b10100000,
+  0b10100000, 0b10100000,
+  0b00011011, 0b00000000,
+};
+
+RGBMatrixSprite invaders[3];
+int16_t invaderX = 0;
+int8_t invaderStep = 1;
+
+void setup() {
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 6, true);
+  RGBMatrix.enable();
+
+  // One color per sprite, the mask gives the shape
+  const uint8_t colors[3][3] = {{255, 40, 40}, {40, 255, 40}, {60, 60, 255}};
+  for (uint8_t i = 0; i < 3; i++)
+    invaders[i].begin(INVADER_W, INVADER_H, invaderMask, colors[i][0], colors[i][1], colors[i][2]);
+}
+
+void loop() {
+  RGBMatrix.clearDisplay();
+  for (uint8_t i = 0; i < 3; i++)
+    invaders[i].draw(invaderX + 16 * i, 4 + 9 * (i & 1));
+  RGBMatrix.showBuffer();
+
+  invaderX += invaderStep;
+  if ((invaderX < -4) || (invaderX > 64 - 2 * 16 - INVADER_W + 4))
+    invaderStep = -invaderStep;
+  delay(60);
+}
@@ -0,0 +1,30 @@
+// Streams an animation from LittleFS : upload data/anim.bin with the file system uploader.
+// anim.bin is made with extras/tools/rgbmatrix_delta (or rgbmatrix_asset) and the -b option :
+//   ./rgbmatrix_delta -w 64 -h 32 -d 6 -t 40 -b data/anim.bin anim.rgb > /dev/null
+// The options must match the setup below (-D 2 for double buffering, the default).
+#include <LittleFS.h>
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixStream.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+RGBMatrixStream animation;
+
+void setup() {
+  Serial.begin(115200);
+  LittleFS.begin();
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 6, true);
+  RGBMatrix.enable();
+  if (!animation.begin(LittleFS.open("/anim.bin", "r")))
+    Serial.println("anim.bin missing or encoded for another layout");
+}
+
+void loop() {
+  animation.update();
+}
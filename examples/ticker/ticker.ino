@@ -0,0 +1,38 @@
+// Marquee : the text is drawn once on a canvas wider than the panel, each step only moves the window.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixCanvas.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+const char* message = "   Hello from the ESP8266 RGB matrix driver   ";
+
+// 6 pixels per character with the default font, 2 lines of 8 pixels
+RGBMatrixCanvas canvas(strlen(message) * 6, 16);
+
+void setup() {
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 6, true);
+  RGBMatrix.enable();
+
+  if (!canvas.begin())
+    return;
+  canvas.setTextWrap(false);
+  canvas.setTextColor(canvas.color565(255, 160, 0));
+  canvas.setCursor(0, 0);
+  canvas.print(message);
+  canvas.setTextColor(canvas.color565(0, 120, 255));
+  canvas.setCursor(0, 8);
+  canvas.print(message);
+}
+
+void loop() {
+  canvas.draw();
+  RGBMatrix.showBuffer();
+  canvas.scroll(1, 0);
+  delay(30);
+}
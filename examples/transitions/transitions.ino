@@ -0,0 +1,71 @@
+// Two animated scenes alternating every 5 seconds through a fade, two wipes and a dissolve. During a
+// transition both scenes keep drawing, each into its own encoded frame, and the shown frame is composed
+// from them in the bitplanes.
+#include <ESP8266RGBMatrix.h>
+#include <RGBMatrixTransition.h>
+
+#define P_LAT 16
+#define P_A 5
+#define P_B 4
+#define P_C 15
+#define P_D 12
+#define P_OE 2
+
+RGBMatrixTransition transition;
+uint8_t scene = 0;
+uint8_t mode = TRANSITION_FADE;
+uint32_t lastChange = 0;
+uint8_t phase = 0;
+
+// Scene 0 : horizontal rainbow scrolling, scene 1 : vertical bars of blue moving down
+void drawScene(uint8_t which) {
+  uint8_t rgb[64 * 3];
+  for (int16_t y = 0; y < 32; y++) {
+    for (int16_t x = 0; x < 64; x++) {
+      uint8_t v = which ? (y * 8 - phase * 2) : (x * 4 + phase);
+      uint8_t* p = rgb + x * 3;
+      if (which) {
+        p[0] = 0;
+        p[1] = v < 128 ? v : 0;
+        p[2] = v;
+      }
+      else {
+        p[0] = v < 128 ? 255 - v * 2 : 0;
+        p[1] = v < 128 ? v * 2 : 255 - (v - 128) * 2;
+        p[2] = v < 128 ? 0 : (v - 128) * 2;
+      }
+    }
+    RGBMatrix.writeRGB888(0, y, rgb, 64);
+  }
+}
+
+void setup() {
+  RGBMatrix.setGPIO(P_OE, P_LAT, P_A, P_B, P_C, P_D);
+  RGBMatrix.begin(64, 32, 4, true);
+  RGBMatrix.enable();
+  transition.begin();
+}
+
+void loop() {
+  phase++;
+  if (millis() - lastChange > 5000) {
+    lastChange = millis();
+    scene ^= 1;
+    transition.start(mode, 40);
+    mode = (mode + 1) % 4;
+  }
+
+  if (transition.isRunning()) {
+    transition.drawFrom();
+    drawScene(scene ^ 1);
+    transition.drawTo();
+    drawScene(scene);
+    transition.drawDone();
+    transition.update();
+  }
+  else
+    drawScene(scene);
+
+  RGBMatrix.showBuffer();
+  delay(20);
+}
@@ -0,0 +1,88 @@
+// Minimal Arduino/ESP8266 environment to build the library on a desktop host.
+// Used by the tools in extras/tools : the frame buffers and the pixel encoding are
+// the real ones, the hardware registers are plain variables and the timer never runs.
+#ifndef RGBMATRIX_HOST_ARDUINO_H
+#define RGBMATRIX_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <new>
+
+#define RGBMATRIX_HOST
+
+// Registers
+extern volatile uint32_t host_regs[32];
+#define GPIO_OUT_W1TS_ADDRESS	0x04
+#define GPIO_OUT_W1TC_ADDRESS	0x08
+#define GPIO_REG_WRITE(reg, val)	(host_regs[(reg) / 4] = (val))
+#define ESP8266_DREG(addr)		host_regs[3]
+#define SPI1CMD					host_regs[4]
+#define SPI1U1					host_regs[5]
+#define T1L						host_regs[6]
+#define T1C						host_regs[7]
+#define TEIE					host_regs[8]
+#define CPU2X					host_regs[9]
+#define SPI1W0					host_regs[16]
+#define SPIBUSY					0			// The shift is instantaneous : refresh() can run on the host
+#define SPIMMOSI				0x1FF
+#define SPILMOSI				17
+#define TEIE1					0x02
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PROGMEM
+#define PSTR(s)					(s)
+#define memcpy_P				memcpy
+#define pgm_read_byte(addr)		(*(const uint8_t*)(addr))
+#define pgm_read_word(addr)		(*(const uint16_t*)(addr))
+#define pgm_read_dword(addr)	(*(const uint32_t*)(addr))
+
+#define LOW		0
+#define HIGH	1
+#define INPUT	0
+#define OUTPUT	1
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+// Interrupts and timer1
+#define noInterrupts()
+#define interrupts()
+inline uint32_t xt_rsil(uint32_t) { return 0; }
+inline void xt_wsr_ps(uint32_t) {}
+#define ETS_FRC1_INTR_ENABLE()
+#define TIM_DIV16	1
+#define TIM_EDGE	0
+#define TIM_LOOP	1
+typedef void (*timercallback)(void);
+inline void timer1_isr_init() {}
+inline void timer1_attachInterrupt(timercallback) {}
+inline void timer1_enable(uint8_t, uint8_t, uint8_t) {}
+inline void timer1_write(uint32_t) {}
+inline void timer1_disable() {}
+extern "C" void NmiTimSetFunc(void (*func)(void));
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+inline long random(long howmax) { return howmax > 0 ? ::random() % howmax : 0; }
+
+class EspClass {
+public:
+	uint8_t getCpuFreqMHz() { return 160; }
+	uint32_t getCycleCount();
+};
+extern EspClass ESP;
+
+class HardwareSerial {
+public:
+	void begin(unsigned long) {}
+	template <typename... Args>
+	int printf(const char* format, Args... args) { return ::printf(format, args...); }
+};
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,99 @@
+// Stream over a file descriptor (tty, pty) for the host tools
+#ifndef RGBMATRIX_HOST_HOSTSERIAL_H
+#define RGBMATRIX_HOST_HOSTSERIAL_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "Stream.h"
+
+class HostSerial : public Stream {
+public:
+	~HostSerial() { close(); }
+
+	// Raw mode, non blocking reads. baud 0 keeps the speed (pty)
+	bool open(const char* path, uint32_t baud = 0) {
+		close();
+		int fd = ::open(path, O_RDWR | O_NOCTTY);
+		if (fd < 0)
+			return false;
+		attach(fd, baud);
+		return true;
+	}
+
+	void attach(int fd, uint32_t baud = 0) {
+		_fd = fd;
+		termios tio;
+		if (!tcgetattr(_fd, &tio)) {
+			cfmakeraw(&tio);
+			if (baud) {
+				speed_t speed = baud >= 921600 ? B921600 : baud >= 460800 ? B460800 : baud >= 230400 ? B230400 : B115200;
+				cfsetspeed(&tio, speed);
+			}
+			tcsetattr(_fd, TCSANOW, &tio);
+		}
+		fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL) | O_NONBLOCK);
+		_size = _pos = 0;
+	}
+
+	void close() {
+		if (_fd >= 0)
+			::close(_fd);
+		_fd = -1;
+	}
+
+	int available() override {
+		if (_pos == _size) {
+			ssize_t n = _fd >= 0 ? ::read(_fd, _in, sizeof(_in)) : -1;
+			_size = n > 0 ? n : 0;
+			_pos = 0;
+		}
+		return _size - _pos;
+	}
+
+	int read() override {
+		return available() ? _in[_pos++] : -1;
+	}
+
+	size_t readBytes(uint8_t* buffer, size_t length) override {
+		size_t done = 0;
+		while (done < length && available()) {
+			size_t n = length - done < _size - _pos ? length - done : _size - _pos;
+			memcpy(buffer + done, _in + _pos, n);
+			_pos += n;
+			done += n;
+		}
+		return done;
+	}
+
+	// Blocking, idle() is called while the other side doesn't read (loopback)
+	size_t write(const uint8_t* buffer, size_t size) override {
+		size_t done = 0;
+		while (done < size && _fd >= 0) {
+			ssize_t n = ::write(_fd, buffer + done, size - done);
+			if (n > 0)
+				done += n;
+			else if ((n < 0) && (errno != EAGAIN))
+				break;
+			else if (idle)
+				idle();
+			else {
+				pollfd p = {_fd, POLLOUT, 0};
+				poll(&p, 1, 100);
+			}
+		}
+		return done;
+	}
+
+	void (*idle)() = nullptr;
+
+private:
+	int _fd = -1;
+	uint8_t _in[4096];
+	size_t _size = 0;
+	size_t _pos = 0;
+};
+
+#endif
@@ -0,0 +1,90 @@
+// UDP over POSIX sockets for the host tools, non blocking like WiFiUDP
+#ifndef RGBMATRIX_HOST_HOSTUDP_H
+#define RGBMATRIX_HOST_HOSTUDP_H
+
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Udp.h"
+
+class HostUDP : public UDP {
+public:
+	~HostUDP() { stop(); }
+
+	uint8_t begin(uint16_t port) override {
+		if (!open())
+			return 0;
+		sockaddr_in addr = {};
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_ANY);
+		addr.sin_port = htons(port);
+		return bind(_fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+	}
+
+	void stop() override {
+		if (_fd >= 0)
+			close(_fd);
+		_fd = -1;
+	}
+
+	int beginPacket(const char* host, uint16_t port) override {
+		addrinfo hints = {};
+		addrinfo* info;
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_DGRAM;
+		if (!open() || getaddrinfo(host, nullptr, &hints, &info))
+			return 0;
+		_to = *(sockaddr_in*)info->ai_addr;
+		_to.sin_port = htons(port);
+		freeaddrinfo(info);
+		_out.clear();
+		return 1;
+	}
+
+	size_t write(const uint8_t* buffer, size_t size) override {
+		_out.insert(_out.end(), buffer, buffer + size);
+		return size;
+	}
+
+	int endPacket() override {
+		return sendto(_fd, _out.data(), _out.size(), 0, (sockaddr*)&_to, sizeof(_to)) == (ssize_t)_out.size();
+	}
+
+	int parsePacket() override {
+		ssize_t n = _fd >= 0 ? recv(_fd, _in, sizeof(_in), 0) : -1;
+		_size = n > 0 ? n : 0;
+		_pos = 0;
+		return _size;
+	}
+
+	int available() override { return _size - _pos; }
+
+	int read(uint8_t* buffer, size_t len) override {
+		size_t n = len < (size_t)available() ? len : available();
+		memcpy(buffer, _in + _pos, n);
+		_pos += n;
+		return n;
+	}
+
+private:
+	bool open() {
+		if (_fd < 0) {
+			_fd = socket(AF_INET, SOCK_DGRAM, 0);
+			if (_fd >= 0)
+				fcntl(_fd, F_SETFL, O_NONBLOCK);
+		}
+		return _fd >= 0;
+	}
+
+	int _fd = -1;
+	sockaddr_in _to = {};
+	std::vector<uint8_t> _out;
+	uint8_t _in[65536];
+	size_t _size = 0;
+	size_t _pos = 0;
+};
+
+#endif
@@ -0,0 +1,19 @@
+// Host stand-in for the ESP8266 SPI library (see Arduino.h)
+#ifndef RGBMATRIX_HOST_SPI_H
+#define RGBMATRIX_HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0	0x00
+#define MSBFIRST	1
+
+class SPIClass {
+public:
+	void begin() {}
+	void setFrequency(uint32_t) {}
+	void setDataMode(uint8_t) {}
+	void setBitOrder(uint8_t) {}
+};
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,16 @@
+// Arduino Stream interface, the part used by the library (RGBMatrixSerial)
+#ifndef RGBMATRIX_HOST_STREAM_H
+#define RGBMATRIX_HOST_STREAM_H
+
+#include "Arduino.h"
+
+class Stream {
+public:
+	virtual ~Stream() {}
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual size_t readBytes(uint8_t* buffer, size_t length) = 0;
+	virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+};
+
+#endif
@@ -0,0 +1,20 @@
+// Arduino UDP interface, the part used by the library (RGBMatrixDDP)
+#ifndef RGBMATRIX_HOST_UDP_H
+#define RGBMATRIX_HOST_UDP_H
+
+#include "Arduino.h"
+
+class UDP {
+public:
+	virtual ~UDP() {}
+	virtual uint8_t begin(uint16_t port) = 0;
+	virtual void stop() = 0;
+	virtual int beginPacket(const char* host, uint16_t port) = 0;
+	virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+	virtual int endPacket() = 0;
+	virtual int parsePacket() = 0;
+	virtual int available() = 0;
+	virtual int read(uint8_t* buffer, size_t len) = 0;
+};
+
+#endif
@@ -0,0 +1,34 @@
+// Globals of the host environment (see Arduino.h)
+#include <chrono>
+#include <thread>
+#include "Arduino.h"
+#include "SPI.h"
+
+volatile uint32_t host_regs[32];
+EspClass ESP;
+HardwareSerial Serial;
+SPIClass SPI;
+
+static const std::chrono::steady_clock::time_point host_start = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - host_start).count();
+}
+
+unsigned long micros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - host_start).count();
+}
+
+uint32_t EspClass::getCycleCount() {
+	return micros() * getCpuFreqMHz();
+}
+
+void delay(unsigned long ms) {
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {
+	std::this_thread::yield();
+}
+
+extern "C" void NmiTimSetFunc(void (*)(void)) {}
@@ -0,0 +1,170 @@
+// DDP sender for RGBMatrixDDP : raw RGB24 frames (as produced by
+// examples/black_lives/image_to_array.sh) sent to a panel, or to the receiver running here.
+//
+// Build (from this directory) :
+//   g++ -O2 -I../host -I../.. -o ddp_send ddp_send.cpp ../../ESP8266RGBMatrix.cpp ../../RGBMatrixDDP.cpp ../host/host.cpp
+//
+// Examples :
+//   ./ddp_send -H 192.168.1.50 -w 64 -h 32 -t 40 anim.rgb
+//   ./ddp_send -l -w 64 -h 32 -d 6 -s ZIGZAG -n 1000 -x 7 anim.rgb
+//
+// With -l the frames go through the loopback interface to RGBMatrixDDP and every frame shown
+// is compared with the setPixel() encoding of the same layout. -x and -X drop or swap packets
+// to check the dropped and late counters (a swapped packet is counted in both).
+#include "layout_options.h"
+#include "HostUdp.h"
+#include "RGBMatrixDDP.h"
+
+static void usage() {
+	fprintf(stderr, "Usage: ddp_send [options] frames.rgb [frames.rgb ...]\n"
+					LAYOUT_OPTIONS_USAGE
+					"  -H HOST       receiver address (127.0.0.1)\n"
+					"  -P PORT       receiver port (4048)\n"
+					"  -n BYTES      payload bytes per packet (1440)\n"
+					"  -t DELAY      ms between frames (40)\n"
+					"  -L LOOPS      times the frames are sent (1)\n"
+					"  -l            loopback : receive and check the frames here\n"
+					"  -x N          drop every Nth packet\n"
+					"  -X N          swap every Nth packet with the next one\n");
+	exit(1);
+}
+
+int main(int argc, char** argv) {
+	LayoutOptions layout;
+	const char* host = "127.0.0.1";
+	uint16_t port = RGBMATRIX_DDP_PORT;
+	uint16_t packetBytes = 1440;
+	uint16_t frameDelay = 40;
+	uint16_t loops = 1;
+	bool loopback = false;
+	uint32_t dropEvery = 0;
+	uint32_t swapEvery = 0;
+	std::vector<const char*> inputs;
+
+	for (int i = 1; i < argc; i++) {
+		if (parseLayoutOption(layout, argc, argv, &i))
+			continue;
+		if (!strcmp(argv[i], "-H") && i + 1 < argc)			host = argv[++i];
+		else if (!strcmp(argv[i], "-P") && i + 1 < argc)	port = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-n") && i + 1 < argc)	packetBytes = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-t") && i + 1 < argc)	frameDelay = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-L") && i + 1 < argc)	loops = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-x") && i + 1 < argc)	dropEvery = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-X") && i + 1 < argc)	swapEvery = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-l"))					loopback = true;
+		else if (argv[i][0] == '-')							usage();
+		else												inputs.push_back(argv[i]);
+	}
+	if (inputs.empty() || !packetBytes || packetBytes > 1440 || !loops)
+		usage();
+
+	uint32_t rgbSize = layout.width * layout.height * 3;
+	std::vector<uint8_t> rgb;
+	for (const char* input : inputs) {
+		if (!readFile(input, rgb)) {
+			fprintf(stderr, "Can't read %s\n", input);
+			return 1;
+		}
+	}
+	size_t frameCount = rgb.size() / rgbSize;
+	if (!frameCount) {
+		fprintf(stderr, "No complete %ux%u frame\n", layout.width, layout.height);
+		return 1;
+	}
+
+	// Reference encoding of every frame, then a clean buffer for the receiver
+	HostUDP receiver;
+	RGBMatrixDDP ddp;
+	std::vector<std::vector<uint8_t>> expected;
+	if (loopback) {
+		beginLayout(layout);
+		if (!encodeFrames(layout, inputs, [&](const uint8_t* planes, uint32_t size) {
+				expected.push_back(std::vector<uint8_t>(planes, planes + size));
+			}))
+			return 1;
+		RGBMatrix.clearDisplay();
+		if (!ddp.begin(receiver, port)) {
+			fprintf(stderr, "Can't listen on port %u\n", port);
+			return 1;
+		}
+		host = "127.0.0.1";
+	}
+
+	HostUDP sender;
+	std::vector<std::vector<uint8_t>> packets;
+	uint8_t sequence = 0;
+	uint32_t packetCount = 0;
+	uint32_t dropped = 0;
+	uint32_t swapped = 0;
+	uint32_t mismatches = 0;
+	uint32_t checked = 0;
+	for (uint32_t loop = 0; loop < loops; loop++) {
+		for (size_t f = 0; f < frameCount; f++) {
+			const uint8_t* frame = &rgb[f * rgbSize];
+			packets.clear();
+			for (uint32_t offset = 0; offset < rgbSize; offset += packetBytes) {
+				uint16_t length = rgbSize - offset < packetBytes ? rgbSize - offset : packetBytes;
+				sequence = sequence % 15 + 1;
+				uint8_t header[RGBMATRIX_DDP_HEADER] = {
+					(uint8_t)(RGBMATRIX_DDP_VERSION_1 | (offset + length == rgbSize ? RGBMATRIX_DDP_PUSH : 0)),
+					sequence, 0x01, RGBMATRIX_DDP_ID_DISPLAY,
+					(uint8_t)(offset >> 24), (uint8_t)(offset >> 16), (uint8_t)(offset >> 8), (uint8_t)offset,
+					(uint8_t)(length >> 8), (uint8_t)length};
+				std::vector<uint8_t> packet(header, header + sizeof(header));
+				packet.insert(packet.end(), frame + offset, frame + offset + length);
+				packets.push_back(packet);
+			}
+			uint32_t framesBefore = 0;
+			if (loopback) {
+				RGBMatrixDDP::ddpStats stats;
+				ddp.getStats(stats);
+				framesBefore = stats.frames;
+			}
+			for (size_t p = 0; p < packets.size(); p++) {
+				packetCount++;
+				if (dropEvery && !(packetCount % dropEvery) && (p + 1 < packets.size())) {
+					dropped++;
+					continue;
+				}
+				// The PUSH packet stays last, the frame would be shown before its late packet otherwise
+				if (swapEvery && !(packetCount % swapEvery) && (p + 2 < packets.size())) {
+					std::swap(packets[p], packets[p + 1]);
+					swapped++;
+				}
+				sender.beginPacket(host, port);
+				sender.write(packets[p].data(), packets[p].size());
+				sender.endPacket();
+				if (loopback)
+					while (ddp.update());
+			}
+			if (loopback) {
+				RGBMatrixDDP::ddpStats stats;
+				ddp.getStats(stats);
+				if (stats.frames != framesBefore + 1)
+					fprintf(stderr, "Frame %zu not shown\n", f);
+				else if (!dropEvery && !swapEvery) {
+					checked++;
+					if (memcmp(RGBMatrix.getEditBuffer(), expected[f].data(), expected[f].size())) {
+						mismatches++;
+						fprintf(stderr, "Frame %zu differs from the setPixel() encoding\n", f);
+					}
+				}
+			}
+			else
+				delay(frameDelay);
+		}
+	}
+
+	fprintf(stderr, "%u packets sent, %u dropped, %u swapped\n", packetCount - dropped, dropped, swapped);
+	if (loopback) {
+		RGBMatrixDDP::ddpStats stats;
+		ddp.getStats(stats);
+		fprintf(stderr, "Received : %u packets, %u frames, %u dropped, %u late, %u incomplete, %u invalid\n",
+				stats.packets, stats.frames, stats.dropped, stats.late, stats.incomplete, stats.invalid);
+		if (checked)
+			fprintf(stderr, "%u frames checked, %u mismatches\n", checked, mismatches);
+		if (mismatches || stats.frames != loops * frameCount || stats.dropped != dropped + swapped || stats.late != swapped)
+			return 1;
+	}
+	return 0;
+}
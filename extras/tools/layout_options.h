@@ -0,0 +1,154 @@
+// Panel layout options shared by the host tools : parses the command line and sets up
+// RGBMatrix exactly like the sketch does, so the encoded bitplanes match the device.
+#ifndef RGBMATRIX_LAYOUT_OPTIONS_H
+#define RGBMATRIX_LAYOUT_OPTIONS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "ESP8266RGBMatrix.h"
+
+struct LayoutOptions {
+	uint16_t width = 64;
+	uint16_t height = 32;
+	uint8_t colorDepth = RGBMATRIX_DEFAULT_COLOR_DEPTH;
+	uint8_t muxBits = 4;			// Address lines : 3 (A-C), 4 (A-D) or 5 (A-E)
+	scan_patterns scanPattern = LINE;
+	block_patterns blockPattern = ABCD;
+	color_orders colorOrder = RRGGBB;
+	uint8_t panelsWidth = 1;
+	bool rotate = false;
+	bool flip = false;
+	uint8_t offset[3] = {0, 0, 0};
+};
+
+#define LAYOUT_OPTIONS_USAGE \
+	"  -w WIDTH      panel width in pixels (64)\n" \
+	"  -h HEIGHT     panel height in pixels (32)\n" \
+	"  -d DEPTH      color depth 1..8 (6)\n" \
+	"  -m MUXBITS    address lines 3, 4 or 5 (4)\n" \
+	"  -s SCAN       LINE ZIGZAG ZZAGG ZAGGIZ WZAGZIG VZAG ZAGZIG WZAGZIG2 ZZIAGG (LINE)\n" \
+	"  -k BLOCK      ABCD DBCA (ABCD)\n" \
+	"  -o ORDER      RRGGBB RRBBGG GGRRBB GGBBRR BBRRGG BBGGRR (RRGGBB)\n" \
+	"  -p PANELS     panels chained in width (1)\n" \
+	"  -r            rotate\n" \
+	"  -f            flip\n" \
+	"  -c R,G,B      color offset (0,0,0)\n"
+
+inline int layoutFindName(const char* value, const char* const* names, int count) {
+	for (int i = 0; i < count; i++)
+		if (!strcmp(value, names[i]))
+			return i;
+	fprintf(stderr, "Unknown value %s\n", value);
+	exit(1);
+}
+
+// Returns true if argv[*i] was a layout option (and consumes its value)
+inline bool parseLayoutOption(LayoutOptions& layout, int argc, char** argv, int* i) {
+	static const char* const scans[] = {"LINE", "ZIGZAG", "ZZAGG", "ZAGGIZ", "WZAGZIG", "VZAG", "ZAGZIG", "WZAGZIG2", "ZZIAGG"};
+	static const char* const blocks[] = {"ABCD", "DBCA"};
+	static const char* const orders[] = {"RRGGBB", "RRBBGG", "GGRRBB", "GGBBRR", "BBRRGG", "BBGGRR"};
+	const char* arg = argv[*i];
+	if (arg[0] != '-' || !arg[1] || arg[2])
+		return false;
+	if (arg[1] == 'r') { layout.rotate = true; return true; }
+	if (arg[1] == 'f') { layout.flip = true; return true; }
+	if (!strchr("whdmskopc", arg[1]))
+		return false;
+	if (*i + 1 >= argc) {
+		fprintf(stderr, "Missing value for %s\n", arg);
+		exit(1);
+	}
+	const char* value = argv[++*i];
+	switch (arg[1]) {
+		case 'w': layout.width = atoi(value); break;
+		case 'h': layout.height = atoi(value); break;
+		case 'd': layout.colorDepth = atoi(value); break;
+		case 'm': layout.muxBits = atoi(value); break;
+		case 's': layout.scanPattern = (scan_patterns)layoutFindName(value, scans, 9); break;
+		case 'k': layout.blockPattern = (block_patterns)layoutFindName(value, blocks, 2); break;
+		case 'o': layout.colorOrder = (color_orders)layoutFindName(value, orders, 6); break;
+		case 'p': layout.panelsWidth = atoi(value); break;
+		case 'c': {
+			unsigned r, g, b;
+			if (sscanf(value, "%u,%u,%u", &r, &g, &b) != 3) {
+				fprintf(stderr, "Color offset must be R,G,B\n");
+				exit(1);
+			}
+			layout.offset[0] = r; layout.offset[1] = g; layout.offset[2] = b;
+			break;
+		}
+	}
+	return true;
+}
+
+// Same calls as a sketch would do, pins are meaningless on the host
+inline void beginLayout(const LayoutOptions& layout, bool doubleBuffer = false) {
+	if (layout.muxBits == 3)		RGBMatrix.setGPIO(0, 1, 2, 3, 4);
+	else if (layout.muxBits == 5)	RGBMatrix.setGPIO(0, 1, 2, 3, 4, 5, 6);
+	else							RGBMatrix.setGPIO(0, 1, 2, 3, 4, 5);
+	RGBMatrix.setScanPattern(layout.scanPattern);
+	RGBMatrix.setBlockPattern(layout.blockPattern);
+	RGBMatrix.setColorOrder(layout.colorOrder);
+	RGBMatrix.setPanelsWidth(layout.panelsWidth);
+	RGBMatrix.setRotate(layout.rotate);
+	RGBMatrix.setFlip(layout.flip);
+	RGBMatrix.setColorOffset(layout.offset[0], layout.offset[1], layout.offset[2]);
+	RGBMatrix.begin(layout.width, layout.height, layout.colorDepth, doubleBuffer);
+}
+
+inline bool readFile(const char* name, std::vector<uint8_t>& data) {
+	FILE* f = fopen(name, "rb");
+	if (!f)
+		return false;
+	uint8_t chunk[4096];
+	size_t n;
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+		data.insert(data.end(), chunk, chunk + n);
+	fclose(f);
+	return true;
+}
+
+inline bool writeFile(const char* name, const std::vector<uint8_t>& data) {
+	FILE* f = fopen(name, "wb");
+	if (!f)
+		return false;
+	bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+	return (fclose(f) == 0) && ok;
+}
+
+// Encode raw RGB24 frames (row major, width * height * 3 bytes each) with the real setPixel(),
+// calls frame() with the bitplanes of each one
+template <typename Callback>
+inline bool encodeFrames(const LayoutOptions& layout, const std::vector<const char*>& inputs, Callback frame) {
+	uint32_t rgbSize = layout.width * layout.height * 3;
+	for (const char* input : inputs) {
+		std::vector<uint8_t> rgb;
+		if (!readFile(input, rgb)) {
+			fprintf(stderr, "Can't read %s\n", input);
+			return false;
+		}
+		if (rgb.size() % rgbSize)
+			fprintf(stderr, "%s : %zu trailing bytes ignored\n", input, rgb.size() % rgbSize);
+		for (size_t pos = 0; pos + rgbSize <= rgb.size(); pos += rgbSize) {
+			const uint8_t* pixel = &rgb[pos];
+			for (int16_t y = 0; y < layout.height; y++)
+				for (int16_t x = 0; x < layout.width; x++, pixel += 3)
+					RGBMatrix.setPixel(x, y, pixel[0], pixel[1], pixel[2]);
+			const uint8_t* planes = RGBMatrix.getEditBuffer();
+			frame(planes, RGBMatrix.getFrameSize());
+		}
+	}
+	return true;
+}
+
+// C array for PROGMEM, 32 bits aligned so it can be read by words
+inline void printArray(const char* name, const std::vector<uint8_t>& data) {
+	printf("const uint8_t %s[] PROGMEM __attribute__((aligned(4))) = {", name);
+	for (size_t i = 0; i < data.size(); i++)
+		printf("%s0x%02x", i ? (i % 16 ? "," : ",\n") : "\n", data[i]);
+	printf("};\n");
+}
+
+#endif
@@ -0,0 +1,82 @@
+// Host converter for RGBMatrixAsset : raw RGB24 frames (as produced by
+// examples/black_lives/image_to_array.sh) to a pre-encoded PROGMEM asset.
+//
+// Build (from this directory) :
+//   g++ -O2 -I../host -I../.. -o rgbmatrix_asset rgbmatrix_asset.cpp ../../ESP8266RGBMatrix.cpp ../host/host.cpp
+//
+// Example :
+//   ffmpeg -i anim.gif -vf scale=64:32 -f rawvideo -pix_fmt rgb24 anim.rgb
+//   ./rgbmatrix_asset -w 64 -h 32 -d 6 -t 80 -n anim anim.rgb > anim_encoded.h
+//
+// The layout options must be the ones of the sketch, RGBMatrixAsset::begin() refuses the asset otherwise.
+#include "layout_options.h"
+#include "RGBMatrixAsset.h"
+
+static void usage() {
+	fprintf(stderr, "Usage: rgbmatrix_asset [options] frames.rgb [frames.rgb ...]\n"
+					LAYOUT_OPTIONS_USAGE
+					"  -t DELAY      ms between frames (100)\n"
+					"  -n NAME       array name (asset)\n"
+					"  -b FILE       also write the asset as a binary file\n");
+	exit(1);
+}
+
+int main(int argc, char** argv) {
+	LayoutOptions layout;
+	uint16_t frameDelay = 100;
+	const char* name = "asset";
+	const char* binName = nullptr;
+	std::vector<const char*> inputs;
+
+	for (int i = 1; i < argc; i++) {
+		if (parseLayoutOption(layout, argc, argv, &i))
+			continue;
+		if (!strcmp(argv[i], "-t") && i + 1 < argc)			frameDelay = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-n") && i + 1 < argc)	name = argv[++i];
+		else if (!strcmp(argv[i], "-b") && i + 1 < argc)	binName = argv[++i];
+		else if (argv[i][0] == '-')							usage();
+		else												inputs.push_back(argv[i]);
+	}
+	if (inputs.empty())
+		usage();
+
+	beginLayout(layout);
+	uint32_t frameSize = RGBMatrix.getFrameSize();
+	uint32_t frameStride = (frameSize + 3) & ~3;
+
+	std::vector<uint8_t> frames;
+	bool ok = encodeFrames(layout, inputs, [&](const uint8_t* planes, uint32_t size) {
+		frames.insert(frames.end(), planes, planes + size);
+		frames.resize(frames.size() + frameStride - size, 0);
+	});
+	if (!ok)
+		return 1;
+
+	rgbmatrix_asset_header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = RGBMATRIX_ASSET_MAGIC;
+	header.version = RGBMATRIX_ASSET_VERSION;
+	header.colorDepth = layout.colorDepth;
+	header.rowPattern = 1 << layout.muxBits;
+	header.scanPattern = layout.scanPattern;
+	header.width = layout.width;
+	header.height = layout.height;
+	header.frameCount = frames.size() / frameStride;
+	header.frameDelay = frameDelay;
+	header.frameSize = frameSize;
+	header.layoutSignature = RGBMatrix.getLayoutSignature();
+
+	std::vector<uint8_t> asset((const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+	asset.insert(asset.end(), frames.begin(), frames.end());
+
+	if (binName && !writeFile(binName, asset)) {
+		fprintf(stderr, "Can't write %s\n", binName);
+		return 1;
+	}
+
+	printf("// Generated by rgbmatrix_asset : %ux%u, %u bits, 1/%u scan, %u frames of %u bytes\n",
+		   header.width, header.height, header.colorDepth, header.rowPattern, header.frameCount, header.frameSize);
+	printArray(name, asset);
+	fprintf(stderr, "%u frames, %zu bytes\n", header.frameCount, asset.size());
+	return 0;
+}
@@ -0,0 +1,167 @@
+// Host encoder for RGBMatrixDelta : raw RGB24 frames (as produced by
+// examples/black_lives/image_to_array.sh) to a delta compressed animation.
+//
+// Build (from this directory) :
+//   g++ -O2 -I../host -I../.. -o rgbmatrix_delta rgbmatrix_delta.cpp ../../ESP8266RGBMatrix.cpp ../../RGBMatrixDelta.cpp ../host/host.cpp
+//
+// Example :
+//   ffmpeg -i anim.gif -vf scale=64:32 -f rawvideo -pix_fmt rgb24 anim.rgb
+//   ./rgbmatrix_delta -w 64 -h 32 -d 6 -t 40 -n anim anim.rgb > anim_delta.h
+//
+// Frames are XORed against the frame the edit buffer will hold when they are decoded :
+// the previous one (-D 1, single buffer) or the one before (-D 2, double buffer, default).
+// The stream is decoded back with RGBMatrixDelta::applyFrame() and checked before being written.
+#include "layout_options.h"
+#include "RGBMatrixDelta.h"
+
+static void usage() {
+	fprintf(stderr, "Usage: rgbmatrix_delta [options] frames.rgb [frames.rgb ...]\n"
+					LAYOUT_OPTIONS_USAGE
+					"  -D DISTANCE   1 for a single buffer, 2 for double buffering (2)\n"
+					"  -K INTERVAL   force a keyframe every INTERVAL frames (0 = only when smaller)\n"
+					"  -t DELAY      ms between frames (100)\n"
+					"  -n NAME       array name (animation)\n"
+					"  -b FILE       also write the animation as a binary file (for RGBMatrixStream)\n");
+	exit(1);
+}
+
+static void writeVarint(std::vector<uint8_t>& out, uint32_t value) {
+	while (value >= 0x80) {
+		out.push_back((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	out.push_back(value);
+}
+
+// Runs of changed bytes, gaps too short to pay for a new run header are kept in the run
+static std::vector<uint8_t> encodeRuns(const std::vector<uint8_t>& base, const std::vector<uint8_t>& frame) {
+	std::vector<uint8_t> out;
+	size_t last = 0;
+	size_t i = 0;
+	while (i < frame.size()) {
+		if (base[i] == frame[i]) {
+			i++;
+			continue;
+		}
+		size_t end = i;
+		size_t gap = 0;
+		for (size_t j = i; j < frame.size() && gap < 3; j++) {
+			if (base[j] != frame[j]) {
+				end = j + 1;
+				gap = 0;
+			}
+			else
+				gap++;
+		}
+		writeVarint(out, i - last);
+		writeVarint(out, end - i);
+		for (size_t j = i; j < end; j++)
+			out.push_back(base[j] ^ frame[j]);
+		last = i = end;
+	}
+	return out;
+}
+
+int main(int argc, char** argv) {
+	LayoutOptions layout;
+	uint8_t distance = 2;
+	uint16_t keyInterval = 0;
+	uint16_t frameDelay = 100;
+	const char* name = "animation";
+	const char* binName = nullptr;
+	std::vector<const char*> inputs;
+
+	for (int i = 1; i < argc; i++) {
+		if (parseLayoutOption(layout, argc, argv, &i))
+			continue;
+		if (!strcmp(argv[i], "-D") && i + 1 < argc)			distance = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-K") && i + 1 < argc)	keyInterval = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-t") && i + 1 < argc)	frameDelay = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-n") && i + 1 < argc)	name = argv[++i];
+		else if (!strcmp(argv[i], "-b") && i + 1 < argc)	binName = argv[++i];
+		else if (argv[i][0] == '-')							usage();
+		else												inputs.push_back(argv[i]);
+	}
+	if (inputs.empty() || distance < 1 || distance > 2)
+		usage();
+
+	beginLayout(layout, distance == 2);
+	std::vector<std::vector<uint8_t>> frames;
+	if (!encodeFrames(layout, inputs, [&](const uint8_t* planes, uint32_t size) {
+			frames.push_back(std::vector<uint8_t>(planes, planes + size));
+		}))
+		return 1;
+	if (frames.empty() || frames.size() > 0xFFFF) {
+		fprintf(stderr, "Need 1 to 65535 frames\n");
+		return 1;
+	}
+
+	uint32_t frameSize = RGBMatrix.getFrameSize();
+	std::vector<uint8_t> empty(frameSize, 0);
+	std::vector<uint8_t> records;
+	uint32_t keyframes = 0;
+	for (size_t i = 0; i < frames.size(); i++) {
+		// The first frames of each buffer have nothing to patch (the stream also loops back to them)
+		std::vector<uint8_t> key = encodeRuns(empty, frames[i]);
+		std::vector<uint8_t> payload;
+		uint8_t type = RGBMATRIX_DELTA_KEYFRAME;
+		bool forceKey = (i < distance) || (keyInterval && (i % keyInterval) < distance);
+		if (!forceKey) {
+			payload = encodeRuns(frames[i - distance], frames[i]);
+			if (payload.size() < key.size())
+				type = 0;
+		}
+		if (type & RGBMATRIX_DELTA_KEYFRAME) {
+			payload = key;
+			keyframes++;
+		}
+		uint32_t record = RGBMATRIX_DELTA_RECORD(type, payload.size());
+		records.insert(records.end(), (const uint8_t*)&record, (const uint8_t*)&record + 4);
+		records.insert(records.end(), payload.begin(), payload.end());
+		records.resize((records.size() + 3) & ~3, 0);
+	}
+
+	rgbmatrix_delta_header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = RGBMATRIX_DELTA_MAGIC;
+	header.version = RGBMATRIX_DELTA_VERSION;
+	header.deltaDistance = distance;
+	header.frameCount = frames.size();
+	header.frameDelay = frameDelay;
+	header.frameSize = frameSize;
+	header.layoutSignature = RGBMatrix.getLayoutSignature();
+	header.dataSize = records.size();
+
+	// Decode it back the way the player does, twice to check the loop
+	std::vector<std::vector<uint8_t>> buffers(distance, std::vector<uint8_t>((frameSize + 3) & ~3, 0xA5));
+	size_t offset = 0;
+	for (size_t pass = 0; pass < 2 * frames.size(); pass++) {
+		size_t i = pass % frames.size();
+		if (!i)
+			offset = 0;
+		const uint8_t* record = records.data() + offset;
+		uint32_t length = *(const uint32_t*)record >> 8;
+		std::vector<uint8_t>& buffer = buffers[pass % distance];
+		if (!RGBMatrixDelta::applyFrame(buffer.data(), frameSize, record[0], record + 4, length)
+			|| memcmp(buffer.data(), frames[i].data(), frameSize)) {
+			fprintf(stderr, "Decoding check failed on frame %zu\n", i);
+			return 1;
+		}
+		offset += 4 + ((length + 3) & ~3);
+	}
+
+	std::vector<uint8_t> animation((const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+	animation.insert(animation.end(), records.begin(), records.end());
+	if (binName && !writeFile(binName, animation)) {
+		fprintf(stderr, "Can't write %s\n", binName);
+		return 1;
+	}
+
+	printf("// Generated by rgbmatrix_delta : %ux%u, %u bits, 1/%u scan, %u frames (%u keyframes), %zu bytes instead of %zu\n",
+		   layout.width, layout.height, layout.colorDepth, 1 << layout.muxBits, header.frameCount, keyframes,
+		   animation.size(), (size_t)frameSize * frames.size());
+	printArray(name, animation);
+	fprintf(stderr, "%u frames (%u keyframes), %zu bytes instead of %zu\n", header.frameCount, keyframes,
+			animation.size(), (size_t)frameSize * frames.size());
+	return 0;
+}
@@ -0,0 +1,429 @@
+// Reference sender for RGBMatrixSerial : raw RGB24 frames (as produced by
+// examples/black_lives/image_to_array.sh) pushed over a serial port, or over a pty to the
+// receiver running here.
+//
+// Build (from this directory) :
+//   g++ -O2 -I../host -I../.. -o serial_send serial_send.cpp ../../ESP8266RGBMatrix.cpp ../../RGBMatrixSerial.cpp ../host/host.cpp
+//
+// Examples :
+//   ./serial_send -p /dev/ttyUSB0 -b 921600 -w 64 -h 32 -R anim.rgb
+//   ./serial_send -l -w 64 -h 32 -d 6 -M planes -x 13 -e 17 anim.rgb
+//
+// Modes (-M) : rgb888, rgb565, indexed (palette of the frame colors, rgb888 above 256 colors)
+// or planes (bitplanes encoded here, the panel layout must match : same options as the sketch).
+// -R only sends the rectangle that changed since the previous frame.
+// With -l the packets go through a pty to RGBMatrixSerial and every frame is compared with the
+// setPixel() encoding before its SHOW. -x and -e drop or corrupt packets to exercise the recovery.
+#include <deque>
+#include <map>
+#include <stdlib.h>
+#include "layout_options.h"
+#include "HostSerial.h"
+#include "RGBMatrixSerial.h"
+
+static void usage() {
+	fprintf(stderr, "Usage: serial_send [options] frames.rgb [frames.rgb ...]\n"
+					LAYOUT_OPTIONS_USAGE
+					"  -p DEVICE     serial port\n"
+					"  -b BAUD       serial speed (921600)\n"
+					"  -M MODE       rgb888 rgb565 indexed planes (rgb888)\n"
+					"  -R            dirty rectangles\n"
+					"  -t DELAY      ms between frames (40)\n"
+					"  -L LOOPS      times the frames are sent (1)\n"
+					"  -l            loopback : receive and check the frames here, through a pty\n"
+					"  -x N          drop one packet in N, at random\n"
+					"  -e N          corrupt one packet in N, at random\n");
+	exit(1);
+}
+
+static RGBMatrixSerial receiver;
+static HostSerial receiverPort;
+
+// Loopback : the receiver loop() and the refresh run while the sender waits
+static void loopbackIdle() {
+	receiver.update();
+	RGBMatrix.refreshTest();
+}
+
+class Sender {
+public:
+	HostSerial port;
+	void (*idle)() = nullptr;
+	rgbmatrix_serial_info info;
+	uint32_t dropEvery = 0;
+	uint32_t corruptEvery = 0;
+	uint32_t sent = 0;
+	uint32_t resent = 0;
+	uint32_t dropped = 0;
+	uint32_t corrupted = 0;
+	uint32_t timeout = 200;			// ms without ACK before sending the window again
+
+	bool hello() {
+		for (int retry = 0; retry < 5; retry++) {
+			_info = false;
+			uint8_t sequence = _next;
+			std::vector<uint8_t> packet = build(RGBMATRIX_SERIAL_HELLO, sequence, nullptr, 0);
+			port.write(packet.data(), packet.size());
+			unsigned long start = millis();
+			while (!_info && millis() - start < 500)
+				poll();
+			if (_info && _infoSequence == sequence) {
+				_next = sequence + 1;
+				return true;
+			}
+			_next++;
+		}
+		return false;
+	}
+
+	void send(uint8_t type, const std::vector<uint8_t>& payload) {
+		while (_inflight.size() >= info.window)
+			poll();
+		if (_inflight.empty())
+			_progress = millis();
+		_inflight.push_back({_next, build(type, _next, payload.data(), payload.size())});
+		_next++;
+		transmit(_inflight.back().bytes);
+	}
+
+	void drain() {
+		while (!_inflight.empty())
+			poll();
+	}
+
+private:
+	struct Packet {
+		uint8_t sequence;
+		std::vector<uint8_t> bytes;
+	};
+
+	std::vector<uint8_t> build(uint8_t type, uint8_t sequence, const uint8_t* payload, uint16_t length) {
+		std::vector<uint8_t> packet = {RGBMATRIX_SERIAL_SYNC, type, sequence, (uint8_t)length, (uint8_t)(length >> 8)};
+		packet.insert(packet.end(), payload, payload + length);
+		uint16_t crc = rgbmatrix_crc16(0xFFFF, packet.data() + 1, packet.size() - 1);
+		packet.push_back(crc);
+		packet.push_back(crc >> 8);
+		return packet;
+	}
+
+	void transmit(const std::vector<uint8_t>& packet) {
+		sent++;
+		if (dropEvery && !(rand() % dropEvery)) {
+			dropped++;
+			return;
+		}
+		if (corruptEvery && !(rand() % corruptEvery)) {
+			std::vector<uint8_t> bad = packet;
+			bad[RGBMATRIX_SERIAL_HEADER + rand() % (bad.size() - RGBMATRIX_SERIAL_HEADER)] ^= 0x10;
+			corrupted++;
+			port.write(bad.data(), bad.size());
+			return;
+		}
+		port.write(packet.data(), packet.size());
+	}
+
+	// Go back N : everything from this sequence again
+	void resendFrom(uint8_t sequence) {
+		bool found = false;
+		for (Packet& packet : _inflight) {
+			found |= packet.sequence == sequence;
+			if (found) {
+				resent++;
+				transmit(packet.bytes);
+			}
+		}
+		_progress = millis();
+	}
+
+	void poll() {
+		if (idle)
+			idle();
+		uint8_t buffer[256];
+		size_t n = port.readBytes(buffer, sizeof(buffer));
+		_rx.insert(_rx.end(), buffer, buffer + n);
+		while (!_rx.empty()) {
+			if (_rx[0] != RGBMATRIX_SERIAL_SYNC) {
+				_rx.erase(_rx.begin());
+				continue;
+			}
+			if (_rx.size() < RGBMATRIX_SERIAL_HEADER)
+				break;
+			size_t length = _rx[3] | (_rx[4] << 8);
+			size_t size = RGBMATRIX_SERIAL_HEADER + length + RGBMATRIX_SERIAL_CRC;
+			if (length > 64) {
+				_rx.erase(_rx.begin());
+				continue;
+			}
+			if (_rx.size() < size)
+				break;
+			uint16_t crc = rgbmatrix_crc16(0xFFFF, _rx.data() + 1, size - 1 - RGBMATRIX_SERIAL_CRC);
+			if (crc == (_rx[size - 2] | (_rx[size - 1] << 8)))
+				reply(_rx[1], _rx[2], _rx.data() + RGBMATRIX_SERIAL_HEADER, length);
+			_rx.erase(_rx.begin(), _rx.begin() + (crc == (_rx[size - 2] | (_rx[size - 1] << 8)) ? size : 1));
+		}
+		// Lost ACK or NAK
+		if (!_inflight.empty() && millis() - _progress > timeout)
+			resendFrom(_inflight.front().sequence);
+		if (!idle && !n)
+			usleep(200);
+	}
+
+	void reply(uint8_t type, uint8_t sequence, const uint8_t* payload, size_t length) {
+		if ((type == RGBMATRIX_SERIAL_INFO) && (length == sizeof(info))) {
+			memcpy(&info, payload, sizeof(info));
+			_info = true;
+			_infoSequence = sequence;
+		}
+		else if (type == RGBMATRIX_SERIAL_ACK) {
+			while (!_inflight.empty() && (uint8_t)(sequence - _inflight.front().sequence) < 128) {
+				_inflight.pop_front();
+				_progress = millis();
+			}
+		}
+		else if (type == RGBMATRIX_SERIAL_NAK)
+			resendFrom(sequence);
+	}
+
+	std::deque<Packet> _inflight;
+	std::vector<uint8_t> _rx;
+	uint8_t _next = 0;
+	unsigned long _progress = 0;
+	bool _info = false;
+	uint8_t _infoSequence = 0;
+};
+
+// RGB565 as the panel expands it (rgb565to888())
+static uint16_t toRGB565(const uint8_t* rgb) {
+	return ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+}
+
+static void put16(std::vector<uint8_t>& out, uint16_t value) {
+	out.push_back(value);
+	out.push_back(value >> 8);
+}
+
+int main(int argc, char** argv) {
+	LayoutOptions layout;
+	const char* device = nullptr;
+	uint32_t baud = 921600;
+	const char* mode = "rgb888";
+	bool dirty = false;
+	uint16_t frameDelay = 40;
+	uint16_t loops = 1;
+	bool loopback = false;
+	Sender sender;
+	std::vector<const char*> inputs;
+
+	for (int i = 1; i < argc; i++) {
+		if (parseLayoutOption(layout, argc, argv, &i))
+			continue;
+		if (!strcmp(argv[i], "-p") && i + 1 < argc)			device = argv[++i];
+		else if (!strcmp(argv[i], "-b") && i + 1 < argc)	baud = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-M") && i + 1 < argc)	mode = argv[++i];
+		else if (!strcmp(argv[i], "-t") && i + 1 < argc)	frameDelay = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-L") && i + 1 < argc)	loops = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-x") && i + 1 < argc)	sender.dropEvery = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-e") && i + 1 < argc)	sender.corruptEvery = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-R"))					dirty = true;
+		else if (!strcmp(argv[i], "-l"))					loopback = true;
+		else if (argv[i][0] == '-')							usage();
+		else												inputs.push_back(argv[i]);
+	}
+	int format = !strcmp(mode, "rgb888") ? RGBMATRIX_SERIAL_RGB888 : !strcmp(mode, "rgb565") ? RGBMATRIX_SERIAL_RGB565
+				 : !strcmp(mode, "indexed") ? RGBMATRIX_SERIAL_INDEXED : !strcmp(mode, "planes") ? -1 : -2;
+	if (inputs.empty() || (format == -2) || (!device && !loopback) || !loops || (dirty && format < 0))
+		usage();
+
+	uint32_t rgbSize = layout.width * layout.height * 3;
+	std::vector<uint8_t> rgb;
+	for (const char* input : inputs) {
+		if (!readFile(input, rgb)) {
+			fprintf(stderr, "Can't read %s\n", input);
+			return 1;
+		}
+	}
+	size_t frameCount = rgb.size() / rgbSize;
+	if (!frameCount) {
+		fprintf(stderr, "No complete %ux%u frame\n", layout.width, layout.height);
+		return 1;
+	}
+	// What the panel will show : RGB565 looses the low bits
+	if (format == RGBMATRIX_SERIAL_RGB565)
+		for (size_t i = 0; i < rgb.size(); i += 3)
+			rgb565to888(toRGB565(&rgb[i]), rgb[i], rgb[i + 1], rgb[i + 2]);
+
+	// Bitplanes of every frame with the panel layout : sent in planes mode, the reference in loopback
+	std::vector<std::vector<uint8_t>> planes;
+	if (loopback || format < 0) {
+		beginLayout(layout, true);
+		for (size_t f = 0; f < frameCount; f++) {
+			const uint8_t* pixel = &rgb[f * rgbSize];
+			for (int16_t y = 0; y < layout.height; y++)
+				for (int16_t x = 0; x < layout.width; x++, pixel += 3)
+					RGBMatrix.setPixel(x, y, pixel[0], pixel[1], pixel[2]);
+			planes.push_back(std::vector<uint8_t>(RGBMatrix.getEditBuffer(), RGBMatrix.getEditBuffer() + RGBMatrix.getFrameSize()));
+		}
+	}
+
+	if (loopback) {
+		RGBMatrix.clearDisplay(false);
+		RGBMatrix.clearDisplay(true);
+		int master = posix_openpt(O_RDWR | O_NOCTTY);
+		if ((master < 0) || grantpt(master) || unlockpt(master) || !sender.port.open(ptsname(master))) {
+			fprintf(stderr, "Can't open a pty\n");
+			return 1;
+		}
+		receiverPort.attach(master);
+		receiver.begin(receiverPort);
+		sender.idle = loopbackIdle;
+		sender.port.idle = loopbackIdle;
+	}
+	else if (!sender.port.open(device, baud)) {
+		fprintf(stderr, "Can't open %s\n", device);
+		return 1;
+	}
+
+	if (!sender.hello()) {
+		fprintf(stderr, "No answer to HELLO\n");
+		return 1;
+	}
+	rgbmatrix_serial_info& info = sender.info;
+	// A full window on the wire and some slack
+	sender.timeout = 20 + (uint64_t)info.window * (info.maxPayload + RGBMATRIX_SERIAL_HEADER + RGBMATRIX_SERIAL_CRC) * 10000 / baud;
+	fprintf(stderr, "Panel %ux%u, %u bits, window %u, payload %u\n", info.width, info.height, info.colorDepth, info.window, info.maxPayload);
+	if ((info.width != layout.width) || (info.height != layout.height) || !info.window || (info.maxPayload < 64)) {
+		fprintf(stderr, "Panel size or setup doesn't match\n");
+		return 1;
+	}
+	if ((format < 0) && ((info.layoutSignature != RGBMatrix.getLayoutSignature()) || (info.frameSize != planes[0].size()))) {
+		fprintf(stderr, "The panel layout doesn't match the options, can't send bitplanes\n");
+		return 1;
+	}
+
+	std::vector<uint8_t> previous;
+	uint32_t mismatches = 0;
+	uint32_t fallbacks = 0;
+	uint64_t bytes = 0;
+	unsigned long start = millis();
+	for (uint32_t loop = 0; loop < loops; loop++) {
+		for (size_t f = 0; f < frameCount; f++) {
+			const uint8_t* frame = &rgb[f * rgbSize];
+			if (format < 0) {
+				uint32_t chunk = (info.maxPayload - 4) & ~3;
+				for (uint32_t offset = 0; offset < planes[f].size(); offset += chunk) {
+					uint32_t length = planes[f].size() - offset < chunk ? planes[f].size() - offset : chunk;
+					std::vector<uint8_t> payload((const uint8_t*)&offset, (const uint8_t*)&offset + 4);
+					payload.insert(payload.end(), &planes[f][offset], &planes[f][offset] + length);
+					sender.send(RGBMATRIX_SERIAL_PLANES, payload);
+					bytes += payload.size();
+				}
+			}
+			else {
+				// Rectangle that changed since the previous frame
+				int x0 = 0, y0 = 0, x1 = layout.width - 1, y1 = layout.height - 1;
+				if (dirty && !previous.empty()) {
+					x0 = layout.width;
+					y0 = layout.height;
+					x1 = y1 = -1;
+					for (int y = 0; y < layout.height; y++)
+						for (int x = 0; x < layout.width; x++)
+							if (memcmp(frame + (y * layout.width + x) * 3, &previous[(y * layout.width + x) * 3], 3)) {
+								x0 = std::min(x0, x);
+								x1 = std::max(x1, x);
+								y0 = std::min(y0, y);
+								y1 = std::max(y1, y);
+							}
+				}
+				uint8_t rectFormat = format;
+				std::vector<uint8_t> pixels;
+				std::map<uint32_t, uint8_t> palette;
+				for (int y = y0; y <= y1; y++)
+					for (int x = x0; x <= x1; x++) {
+						const uint8_t* p = frame + (y * layout.width + x) * 3;
+						if (format == RGBMATRIX_SERIAL_RGB565)
+							put16(pixels, toRGB565(p));
+						else
+							pixels.insert(pixels.end(), p, p + 3);
+						if (format == RGBMATRIX_SERIAL_INDEXED)
+							palette.emplace((p[0] << 16) | (p[1] << 8) | p[2], 0);
+					}
+				if (format == RGBMATRIX_SERIAL_INDEXED) {
+					if (palette.size() > 256) {
+						rectFormat = RGBMATRIX_SERIAL_RGB888;
+						fallbacks++;
+					}
+					else {
+						std::vector<uint8_t> entries;
+						uint8_t index = 0;
+						for (auto& color : palette) {
+							color.second = index++;
+							entries.push_back(color.first >> 16);
+							entries.push_back(color.first >> 8);
+							entries.push_back(color.first);
+						}
+						uint32_t perPacket = (info.maxPayload - 1) / 3;
+						for (uint32_t first = 0; first < palette.size(); first += perPacket) {
+							uint32_t count = palette.size() - first < perPacket ? palette.size() - first : perPacket;
+							std::vector<uint8_t> payload(1, first);
+							payload.insert(payload.end(), &entries[first * 3], &entries[(first + count) * 3]);
+							sender.send(RGBMATRIX_SERIAL_PALETTE, payload);
+							bytes += payload.size();
+						}
+						std::vector<uint8_t> indexes;
+						for (size_t i = 0; i < pixels.size(); i += 3)
+							indexes.push_back(palette[(pixels[i] << 16) | (pixels[i + 1] << 8) | pixels[i + 2]]);
+						pixels = indexes;
+					}
+				}
+				uint8_t pixelSize = rectFormat == RGBMATRIX_SERIAL_RGB888 ? 3 : rectFormat == RGBMATRIX_SERIAL_RGB565 ? 2 : 1;
+				uint32_t perPacket = (info.maxPayload - 12) / pixelSize;
+				uint32_t count = pixels.size() / pixelSize;
+				for (uint32_t first = 0; first < count; first += perPacket) {
+					uint32_t n = count - first < perPacket ? count - first : perPacket;
+					std::vector<uint8_t> payload;
+					put16(payload, x0);
+					put16(payload, y0);
+					put16(payload, x1 - x0 + 1);
+					put16(payload, y1 - y0 + 1);
+					payload.push_back(rectFormat);
+					payload.push_back(0);
+					put16(payload, first);
+					payload.insert(payload.end(), &pixels[first * pixelSize], &pixels[(first + n) * pixelSize]);
+					sender.send(RGBMATRIX_SERIAL_RECT, payload);
+					bytes += payload.size();
+				}
+				previous.assign(frame, frame + rgbSize);
+			}
+			if (loopback) {
+				sender.drain();
+				if (memcmp(RGBMatrix.getEditBuffer(), planes[f].data(), planes[f].size())) {
+					mismatches++;
+					fprintf(stderr, "Frame %zu differs from the setPixel() encoding\n", f);
+				}
+			}
+			sender.send(RGBMATRIX_SERIAL_SHOW, std::vector<uint8_t>(1, dirty ? RGBMATRIX_SERIAL_SHOW_COPY : 0));
+			if (!loopback) {
+				sender.drain();
+				delay(frameDelay);
+			}
+		}
+	}
+	sender.drain();
+
+	float seconds = (millis() - start) / 1000.0f;
+	fprintf(stderr, "%u packets, %u sent again, %u dropped, %u corrupted, %llu payload bytes, %.1f frames/s\n",
+			sender.sent, sender.resent, sender.dropped, sender.corrupted, (unsigned long long)bytes,
+			seconds > 0 ? loops * frameCount / seconds : 0.0f);
+	if (fallbacks)
+		fprintf(stderr, "%u frames with more than 256 colors sent as rgb888\n", fallbacks);
+	if (loopback) {
+		RGBMatrixSerial::serialStats stats;
+		receiver.getStats(stats);
+		fprintf(stderr, "Received : %u packets, %u frames, %u CRC errors, %u sequence errors, %u invalid\n",
+				stats.packets, stats.frames, stats.crcErrors, stats.sequenceErrors, stats.invalid);
+		fprintf(stderr, "%zu frames checked, %u mismatches\n", loops * frameCount, mismatches);
+		if (mismatches || (stats.frames != loops * frameCount) || stats.invalid)
+			return 1;
+	}
+	return 0;
+}